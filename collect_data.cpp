@@ -4,12 +4,20 @@
 #include <iomanip>
 #include <vector>
 #include <string>
+#include <cstdlib>
 
 // Data collection program for the report
 // Runs comprehensive benchmarks and outputs CSV for plotting
 
-int main() {
+// Usage: collect_data [seed]   (workload seed, rerun with the same seed to reproduce a CSV)
+
+int main(int argc, char **argv) {
+    if (argc > 1) {
+        set_workload_seed(std::strtoull(argv[1], nullptr, 0));
+    }
+
     std::cout << "Starting comprehensive benchmark data collection..." << std::endl;
+    std::cout << "Workload seed: " << workload_seed() << std::endl;
     std::cout << "This will take several minutes. Please wait..." << std::endl;
     std::cout << std::endl;
 
@@ -17,11 +25,25 @@ int main() {
     std::ofstream csv_file("benchmark_results.csv");
 
     // CSV Header
-    csv_file << "size_kb,pattern,";
+    csv_file << "seed,size_kb,pattern,";
     csv_file << "bw_directaccess,bw_binarysearch,bw_hash1,bw_hash16,";
     csv_file << "lat_directaccess,lat_binarysearch,lat_hash1,lat_hash16";
+    // Structures added later come as {bw, lat} pairs, see benchmark_datastructure()
+    std::vector<std::string> extra_columns = {"bw_openaddr", "lat_openaddr", "bw_swiss", "lat_swiss",
+                                              "bw_cuckoo", "lat_cuckoo", "bw_csr1", "lat_csr1",
+                                              "bw_csr16", "lat_csr16", "bw_eytzinger", "lat_eytzinger",
+                                              "bw_branchless", "lat_branchless", "bw_stree", "lat_stree"};
+    for (auto& column : extra_columns) csv_file << "," << column;
     csv_file << std::endl;
 
+    // Hardware counters per lookup, one row per data structure (-1 where perf is unavailable)
+    std::ofstream counters_file("benchmark_counters.csv");
+    counters_file << "seed,size_kb,pattern,structure,cycles,branch_misses,instructions,llc_misses" << std::endl;
+
+    // Per-lookup latency tail (TSC ticks, timer overhead subtracted), one row per data structure
+    std::ofstream tail_file("benchmark_tail.csv");
+    tail_file << "seed,size_kb,pattern,structure,p50,p99,p999,max,overhead,samples" << std::endl;
+
     // Test sizes: 16KB to 512MB
     std::vector<uint64_t> sizes = {
         16,      // 16 KB  - L1 cache
@@ -57,6 +79,7 @@ int main() {
                 auto results = benchmark_datastructure(size_kb, pattern);
 
                 // Write to CSV
+                csv_file << workload_seed() << ",";
                 csv_file << size_kb << ",";
                 csv_file << pattern_name << ",";
 
@@ -68,18 +91,61 @@ int main() {
                 csv_file << results[4] << "," << results[5] << ","
                          << results[6] << "," << results[7];
 
+                // Later structures
+                for (size_t i = 8; i < 8 + extra_columns.size(); i++) {
+                    csv_file << "," << results[i];
+                }
+
                 csv_file << std::endl;
 
+                for (auto& c : benchmark_datastructure_counters(size_kb, pattern)) {
+                    counters_file << workload_seed() << "," << size_kb << "," << pattern_name << ","
+                                  << c.name << "," << c.cycles << "," << c.branch_misses << ","
+                                  << c.instructions << "," << c.llc_misses << std::endl;
+                }
+
+                for (auto& t : benchmark_datastructure_tail(size_kb, pattern)) {
+                    tail_file << workload_seed() << "," << size_kb << "," << pattern_name << ","
+                              << t.name << "," << t.p50 << "," << t.p99 << "," << t.p999 << ","
+                              << t.max << "," << t.overhead << "," << t.samples << std::endl;
+                }
+
                 std::cout << "✓ Done" << std::endl;
             } catch (const std::exception& e) {
                 std::cout << "✗ Failed: " << e.what() << std::endl;
-                csv_file << size_kb << "," << pattern_name << ",";
-                csv_file << "0,0,0,0,0,0,0,0" << std::endl;
+                csv_file << workload_seed() << "," << size_kb << "," << pattern_name << ",";
+                csv_file << "0,0,0,0,0,0,0,0";
+                for (size_t i = 0; i < extra_columns.size(); i++) csv_file << ",0";
+                csv_file << std::endl;
             }
         }
     }
 
     csv_file.close();
+    counters_file.close();
+    tail_file.close();
+
+    // Build speed per data structure, and the load at which the cuckoo table first had to rehash
+    // (filled in on the cuckoo row only). Neither depends on the lookup pattern.
+    std::ofstream build_file("benchmark_build.csv");
+    build_file << "seed,size_kb,structure,inserts_per_second,max_load" << std::endl;
+    for (uint64_t size_kb : sizes) {
+        std::cout << "Build speed " << size_kb << " KB... ";
+        std::cout.flush();
+        try {
+            double max_load = cuckoo_max_load(size_kb);
+            for (auto& r : insert_throughput(size_kb)) {
+                build_file << workload_seed() << "," << size_kb << "," << r.name << ","
+                           << r.inserts_per_second << ",";
+                if (r.name.rfind("Cuckoo", 0) == 0) build_file << max_load;
+                build_file << std::endl;
+            }
+            std::cout << "✓ Done" << std::endl;
+        } catch (const std::exception& e) {
+            std::cout << "✗ Failed: " << e.what() << std::endl;
+        }
+    }
+    build_file.close();
 
     std::cout << std::endl;
     std::cout << "╔════════════════════════════════════════════════════════════════╗" << std::endl;
@@ -87,6 +153,9 @@ int main() {
     std::cout << "╚════════════════════════════════════════════════════════════════╝" << std::endl;
     std::cout << std::endl;
     std::cout << "Results saved to: benchmark_results.csv" << std::endl;
+    std::cout << "Per-lookup counters saved to: benchmark_counters.csv" << std::endl;
+    std::cout << "Per-lookup latency tail saved to: benchmark_tail.csv" << std::endl;
+    std::cout << "Build speed saved to: benchmark_build.csv" << std::endl;
     std::cout << std::endl;
     std::cout << "Next steps:" << std::endl;
     std::cout << "1. Review the CSV file" << std::endl;
@@ -0,0 +1,18 @@
+#include "Benchmarking.hpp"
+#include <iostream>
+#include <cstdlib>
+
+// Core-to-core cache-line transfer latency matrix
+// Usage: benchmark_core_to_core [seconds]   (time budget for the whole matrix, default 10)
+
+int main(int argc, char **argv) {
+    if (argc > 1) {
+        set_time_budget(std::atof(argv[1]));
+    }
+
+    std::cout << "Measuring core-to-core latency (budget " << time_budget() << " s)..." << std::endl;
+    CoreToCoreMatrix matrix = core_to_core_matrix();
+    print_core_to_core_matrix(std::cout, matrix);
+
+    return 0;
+}
@@ -15,7 +15,27 @@
 #include <vector>
 #include <cassert>
 #include <cstring>
+#include <cctype>
 #include <limits>
+#include <functional>
+#include <memory>
+#include <optional>
+#include <string_view>
+#include <bit>
+#include <stdexcept>
+#include <numeric>
+#include <cmath>
+#include <atomic>
+#include <fstream>
+#include <string>
+#include <barrier>
+#include <pthread.h>
+#include <sched.h>
+#include <immintrin.h>
+#include <array>
+#include <utility>
+#include <sys/mman.h>
+#include <numa.h>
 
 // Benchmarking Suite
 
@@ -26,6 +46,49 @@ enum AccessPattern{
 };
 
 
+// Page sizes backing the node buffers of latency() and bandwidth()
+enum PageSize{
+   PageDefault,   // whatever the allocator and the system THP policy hand out (like std::vector)
+   Page4K,        // regular 4 KB pages, transparent huge pages disabled for the buffer
+   PageTHP,       // transparent huge pages requested with madvise(MADV_HUGEPAGE)
+   Page2M,        // explicit 2 MB pages from the hugetlbfs pool (MAP_HUGETLB)
+   Page1G         // explicit 1 GB pages from the hugetlbfs pool (MAP_HUGETLB)
+};
+
+
+// STREAM kernels (McCalpin), q is a scalar
+enum StreamKernel{
+   Copy,    // c[i] = a[i]
+   Scale,   // b[i] = q * c[i]
+   Add,     // c[i] = a[i] + b[i]
+   Triad    // a[i] = b[i] + q * c[i]
+};
+
+
+// Instruction sets of the full-line read kernels, picked at runtime via CPUID
+enum ReadKernel{
+   ScalarRead,   // 8 x 64-bit loads per line
+   AVX2Read,     // 2 x 256-bit loads per line
+   AVX512Read    // 1 x 512-bit load per line
+};
+
+
+// Store flavours compared by write_bandwidth()
+enum WriteKernel{
+   RegularStore,       // 128-bit stores through the cache, lines are read for ownership first
+   NonTemporalStore,   // _mm_stream_si128, write-combining stores that bypass the caches
+   RepStosb            // rep stosb, what memset boils down to on ERMSB CPUs
+};
+
+enum ContentionKernel{
+   PackedCounters,    // one private counter per thread, all counters adjacent (false sharing)
+   PaddedCounters,    // one private counter per thread, each in its own Node-sized line
+   FetchAdd,          // fetch_add(1) on one shared atomic
+   CompareExchange,   // load + compare_exchange_weak(v, v + 1) retry loop on one shared atomic
+   Exchange           // exchange() on one shared atomic
+};
+
+
 struct alignas(64) Node {
     uint64_t key;
     uint64_t data;
@@ -39,9 +102,35 @@ struct IDataStructure {
     virtual ~IDataStructure() = default;
     virtual void insert(uint64_t key, const Node &node) = 0;
     virtual Node* lookup(uint64_t key) = 0;
+    // Called once all nodes are inserted, for structures that lay themselves out in one go
+    virtual void build() {}
 };
 
 
+// wyrand: counter-based, the n-th number is a 64x64->128 multiply mix of seed + n * increment, so a
+// stream can be split across threads by seeding each with its own offset. Passes BigCrush and
+// PractRand and satisfies UniformRandomBitGenerator, i.e. works with std::shuffle.
+struct WyRand {
+    using result_type = uint64_t;
+    static constexpr uint64_t increment = 0xa0761d6478bd642full;
+
+    uint64_t state;
+
+    static constexpr result_type min() { return 0; }
+    static constexpr result_type max() { return std::numeric_limits<result_type>::max(); }
+
+    inline result_type operator()() {
+        state += increment;
+        __uint128_t product = static_cast<__uint128_t>(state) * (state ^ 0xe7037ed1a0b428dbull);
+        return static_cast<uint64_t>(product >> 64) ^ static_cast<uint64_t>(product);
+    }
+
+    // Uniform in [0, bound) by multiply-shift; the bias is below bound / 2^64
+    inline uint64_t below(uint64_t bound) {
+        return static_cast<uint64_t>((static_cast<__uint128_t>((*this)()) * bound) >> 64);
+    }
+};
+
 
 // Data Structure #1 - Directly accessing an array where the key = index
 class DirectAccessArray : public IDataStructure {
@@ -100,6 +189,259 @@ public:
 };
 
 
+// Data Structure #2b - Binary search over a dense key array in Eytzinger (BFS) order: node k has
+// children 2k and 2k + 1, so the top levels share a few cache lines, the descent is branch-free and
+// the 16 descendants four levels down, 16k .. 16k + 15, are prefetched while the current level is
+// compared; with the array 64-byte aligned they are exactly two cache lines of keys. Payloads sit
+// in a parallel array in the same order. Built once from the staged inserts.
+class EytzingerSearch : public IDataStructure {
+public:
+    static constexpr std::size_t prefetchDistance = 16; // descendants 4 levels down
+    static constexpr std::size_t keysPerLine = 64 / sizeof(uint64_t);
+
+    std::vector<Node> nodes_;   // nodes_[k] belongs to keys_[k], index 0 unused
+    explicit EytzingerSearch(std::size_t expectedCount = 0) { pending_.reserve(expectedCount); }
+
+    inline void insert(uint64_t key, const Node &node) override {
+        pending_.push_back(node);
+        pending_.back().key = key;
+    }
+
+    inline Node* lookup(uint64_t key) override {
+        const uint64_t* keys = keys_.get();
+        std::size_t k = 1;
+        while (k <= size_) {
+            __builtin_prefetch(keys + k * prefetchDistance);
+            __builtin_prefetch(keys + k * prefetchDistance + keysPerLine);
+            k = 2 * k + (keys[k] < key);
+        }
+        // Undo the final run of right turns to land on the lower bound
+        k >>= std::countr_one(k) + 1;
+        return (k != 0 && keys[k] == key) ? &nodes_[k] : nullptr;
+    }
+
+    // Sort the staged nodes by key (a later insert of a key replaces the earlier one) and lay them out
+    void build() override {
+        std::vector<Node> sorted(nodes_.begin() + std::min<std::size_t>(1, nodes_.size()), nodes_.end());
+        sorted.insert(sorted.end(), pending_.begin(), pending_.end());
+        pending_ = {};
+        nodes_ = {};
+        std::stable_sort(sorted.begin(), sorted.end(), [](const Node& a, const Node& b) { return a.key < b.key; });
+        auto last = std::unique(sorted.rbegin(), sorted.rend(), [](const Node& a, const Node& b) { return a.key == b.key; });
+        sorted.erase(sorted.begin(), last.base());
+
+        size_ = sorted.size();
+        // 64-byte aligned, so the prefetched descendants of k start on a line boundary
+        std::size_t bytes = ((size_ + 1) * sizeof(uint64_t) + 63) / 64 * 64;
+        keys_.reset(static_cast<uint64_t*>(std::aligned_alloc(64, bytes)));
+        nodes_.assign(size_ + 1, Node{});
+        keys_[0] = 0;
+        std::size_t next = 0;
+        place(sorted, 1, next);
+    }
+
+private:
+    std::vector<Node> pending_;
+    std::unique_ptr<uint64_t[], decltype(&std::free)> keys_{nullptr, &std::free};
+    std::size_t size_ = 0;
+
+    // In-order traversal of the implicit tree hands out the sorted nodes in ascending order
+    void place(const std::vector<Node>& sorted, std::size_t k, std::size_t& next) {
+        if (k > size_) return;
+        place(sorted, 2 * k, next);
+        keys_[k] = sorted[next].key;
+        nodes_[k] = sorted[next++];
+        place(sorted, 2 * k + 1, next);
+    }
+};
+
+// Data Structure #2c - Branch-free binary search over a dense, sorted key array with the Node
+// payloads in a parallel array. The loop runs a fixed ceil(log2 n) iterations for every key and
+// advances the base with arithmetic instead of a branch, so there is nothing to mispredict.
+// Built once from the staged inserts.
+class BranchlessBinarySearch : public IDataStructure {
+public:
+    std::vector<uint64_t> keys_;
+    std::vector<Node> nodes_;
+    explicit BranchlessBinarySearch(std::size_t expectedCount = 0) { pending_.reserve(expectedCount); }
+
+    inline void insert(uint64_t key, const Node &node) override {
+        pending_.push_back(node);
+        pending_.back().key = key;
+    }
+
+    inline Node* lookup(uint64_t key) override {
+        std::size_t n = keys_.size();
+        if (n == 0) return nullptr;
+        const uint64_t* base = keys_.data();
+        while (n > 1) {
+            std::size_t half = n / 2;
+            base += static_cast<std::size_t>(base[half - 1] < key) * half;
+            n -= half;
+        }
+        std::size_t i = static_cast<std::size_t>(base - keys_.data());
+        return keys_[i] == key ? &nodes_[i] : nullptr;
+    }
+
+    // Sort the staged nodes by key; a later insert of a key replaces the earlier one
+    void build() override {
+        std::vector<Node> sorted = std::move(nodes_);
+        sorted.insert(sorted.end(), pending_.begin(), pending_.end());
+        pending_ = {};
+        std::stable_sort(sorted.begin(), sorted.end(), [](const Node& a, const Node& b) { return a.key < b.key; });
+        auto last = std::unique(sorted.rbegin(), sorted.rend(), [](const Node& a, const Node& b) { return a.key == b.key; });
+        sorted.erase(sorted.begin(), last.base());
+
+        nodes_ = std::move(sorted);
+        keys_.resize(nodes_.size());
+        for (std::size_t i = 0; i < nodes_.size(); i++) keys_[i] = nodes_[i].key;
+    }
+
+private:
+    std::vector<Node> pending_;
+};
+
+// Data Structure #2d - Static B+-tree (S+-tree) over the sorted keys: every node is one cache line
+// of 8 keys with 9 children, stored layer by layer (root first) in one aligned array; the leaves
+// are the sorted keys themselves, padded with all-ones keys, and the Node payloads sit in a
+// parallel array. A node is searched by counting its keys below the search key in one compare:
+// AVX-512 (one 512-bit compare), AVX2 (two 256-bit compares) or scalar, picked at construction
+// and never above what the CPU supports. Built once from the staged inserts; the all-ones key is
+// reserved for padding and cannot be stored.
+class STree : public IDataStructure {
+public:
+    static constexpr std::size_t nodeKeys = 8;
+    static constexpr std::size_t fanout = nodeKeys + 1;
+    static constexpr uint64_t emptyKey = std::numeric_limits<uint64_t>::max();
+
+    struct alignas(64) Block {
+        uint64_t keys[nodeKeys];
+    };
+
+    std::vector<Block> blocks_;
+    std::vector<Node> nodes_;   // payload of the i-th smallest key
+    explicit STree(std::size_t expectedCount = 0, ReadKernel kernel = AVX512Read)
+    {
+        pending_.reserve(expectedCount);
+        __builtin_cpu_init();
+        if (kernel == AVX512Read && !__builtin_cpu_supports("avx512f")) kernel = AVX2Read;
+        if (kernel == AVX2Read && !__builtin_cpu_supports("avx2")) kernel = ScalarRead;
+        kernel_ = kernel;
+        search_ = kernel == AVX512Read ? &STree::searchAVX512 : kernel == AVX2Read ? &STree::searchAVX2 : &STree::searchScalar;
+    }
+
+    inline ReadKernel kernel() const { return kernel_; }
+
+    inline void insert(uint64_t key, const Node &node) override {
+        if (key == emptyKey) throw std::invalid_argument("STree: the all-ones key pads the leaves");
+        pending_.push_back(node);
+        pending_.back().key = key;
+    }
+
+    inline Node* lookup(uint64_t key) override {
+        if (key == emptyKey || nodes_.empty()) return nullptr;
+        return (this->*search_)(key);
+    }
+
+    // Sort the staged nodes by key (a later insert of a key replaces the earlier one) and build the
+    // layers bottom-up: key j of an inner node is the smallest key under its child j + 1
+    void build() override {
+        std::vector<Node> sorted = std::move(nodes_);
+        sorted.insert(sorted.end(), pending_.begin(), pending_.end());
+        pending_ = {};
+        std::stable_sort(sorted.begin(), sorted.end(), [](const Node& a, const Node& b) { return a.key < b.key; });
+        auto last = std::unique(sorted.rbegin(), sorted.rend(), [](const Node& a, const Node& b) { return a.key == b.key; });
+        sorted.erase(sorted.begin(), last.base());
+        nodes_ = std::move(sorted);
+
+        // Layer sizes from the leaves up, then offsets with the root first
+        std::vector<std::size_t> counts{std::max<std::size_t>(1, (nodes_.size() + nodeKeys - 1) / nodeKeys)};
+        while (counts.back() > 1) counts.push_back((counts.back() + fanout - 1) / fanout);
+        layerOffsets_.assign(counts.size(), 0);
+        std::size_t total = 0;
+        for (std::size_t l = counts.size(); l-- > 0;) {
+            layerOffsets_[l] = total;
+            total += counts[l];
+        }
+
+        Block empty;
+        std::fill(std::begin(empty.keys), std::end(empty.keys), emptyKey);
+        blocks_.assign(total, empty);
+        for (std::size_t i = 0; i < nodes_.size(); i++) {
+            blocks_[layerOffsets_[0] + i / nodeKeys].keys[i % nodeKeys] = nodes_[i].key;
+        }
+        std::size_t leavesPerChild = 1; // leaves under one node of the layer below
+        for (std::size_t l = 1; l < counts.size(); l++) {
+            for (std::size_t i = 0; i < counts[l]; i++) {
+                for (std::size_t j = 0; j < nodeKeys; j++) {
+                    std::size_t firstKey = (i * fanout + j + 1) * leavesPerChild * nodeKeys;
+                    if (firstKey < nodes_.size()) blocks_[layerOffsets_[l] + i].keys[j] = nodes_[firstKey].key;
+                }
+            }
+            leavesPerChild *= fanout;
+        }
+    }
+
+private:
+    std::vector<Node> pending_;
+    std::vector<std::size_t> layerOffsets_;   // index of the first block of layer l, l = 0 are the leaves
+    ReadKernel kernel_ = ScalarRead;
+    Node* (STree::*search_)(uint64_t) = &STree::searchScalar;
+
+    // Number of keys of the block below x
+    static inline unsigned rankScalar(const Block& block, uint64_t x) {
+        unsigned rank = 0;
+        for (std::size_t j = 0; j < nodeKeys; j++) rank += block.keys[j] < x;
+        return rank;
+    }
+
+    // AVX2 only compares signed 64-bit integers; flipping the sign bits turns that unsigned
+    __attribute__((target("avx2"))) static inline unsigned rankAVX2(const Block& block, uint64_t x) {
+        const __m256i flip = _mm256_set1_epi64x(std::numeric_limits<long long>::min());
+        __m256i needle = _mm256_xor_si256(_mm256_set1_epi64x(static_cast<long long>(x)), flip);
+        __m256i low = _mm256_xor_si256(_mm256_load_si256(reinterpret_cast<const __m256i*>(block.keys)), flip);
+        __m256i high = _mm256_xor_si256(_mm256_load_si256(reinterpret_cast<const __m256i*>(block.keys + 4)), flip);
+        unsigned mask = static_cast<unsigned>(_mm256_movemask_pd(_mm256_castsi256_pd(_mm256_cmpgt_epi64(needle, low))))
+                      | static_cast<unsigned>(_mm256_movemask_pd(_mm256_castsi256_pd(_mm256_cmpgt_epi64(needle, high)))) << 4;
+        return static_cast<unsigned>(std::popcount(mask));
+    }
+
+    __attribute__((target("avx512f"))) static inline unsigned rankAVX512(const Block& block, uint64_t x) {
+        __mmask8 below = _mm512_cmplt_epu64_mask(_mm512_load_si512(block.keys), _mm512_set1_epi64(static_cast<long long>(x)));
+        return static_cast<unsigned>(std::popcount(static_cast<unsigned>(below)));
+    }
+
+    // Inner layers: child = number of separators <= key; leaf: position = number of keys < key
+    inline Node* leafHit(std::size_t leaf, unsigned position, uint64_t key) {
+        if (position == nodeKeys || blocks_[layerOffsets_[0] + leaf].keys[position] != key) return nullptr;
+        return &nodes_[leaf * nodeKeys + position];
+    }
+
+    Node* searchScalar(uint64_t key) {
+        std::size_t node = 0;
+        for (std::size_t l = layerOffsets_.size() - 1; l > 0; l--) {
+            node = node * fanout + rankScalar(blocks_[layerOffsets_[l] + node], key + 1);
+        }
+        return leafHit(node, rankScalar(blocks_[layerOffsets_[0] + node], key), key);
+    }
+
+    __attribute__((target("avx2"))) Node* searchAVX2(uint64_t key) {
+        std::size_t node = 0;
+        for (std::size_t l = layerOffsets_.size() - 1; l > 0; l--) {
+            node = node * fanout + rankAVX2(blocks_[layerOffsets_[l] + node], key + 1);
+        }
+        return leafHit(node, rankAVX2(blocks_[layerOffsets_[0] + node], key), key);
+    }
+
+    __attribute__((target("avx512f"))) Node* searchAVX512(uint64_t key) {
+        std::size_t node = 0;
+        for (std::size_t l = layerOffsets_.size() - 1; l > 0; l--) {
+            node = node * fanout + rankAVX512(blocks_[layerOffsets_[l] + node], key + 1);
+        }
+        return leafHit(node, rankAVX512(blocks_[layerOffsets_[0] + node], key), key);
+    }
+};
+
 // Data Structure #3 Chained hash table made using a 2D dynamic vector
 class ChainedHashTable : public IDataStructure {
 public:
@@ -153,34 +495,852 @@ private:
     }
 };
 
+// Data Structure #3b - Build-once chained hash table in CSR layout: all nodes in one contiguous
+// array grouped by bucket, bucket b spanning nodes_[offsets_[b] .. offsets_[b + 1]). Same bucket
+// count and (identity) hash as ChainedHashTable, but no per-bucket allocation or vector header.
+// Inserts are staged; lookups only see what was inserted before the last build().
+class CsrChainedHashTable : public IDataStructure {
+public:
+    std::vector<Node> nodes_;
+    std::vector<uint32_t> offsets_;
+    explicit CsrChainedHashTable(std::size_t expectedCount, double bin_size = 1)
+    {
+        std::size_t numBuckets = std::bit_ceil(std::max<std::size_t>(
+            1, static_cast<std::size_t>(std::ceil(expectedCount / bin_size))));
+        offsets_.assign(numBuckets + 1, 0);
+        pending_.reserve(expectedCount);
+    }
+
+    inline void insert(uint64_t key, const Node &node) override {
+        pending_.push_back(node);
+        pending_.back().key = key;
+    }
+
+    inline Node* lookup(uint64_t key) override {
+        std::size_t bucket = indexFor(key);
+        for (uint32_t i = offsets_[bucket]; i < offsets_[bucket + 1]; i++) {
+            if (nodes_[i].key == key) return &nodes_[i];
+        }
+        return nullptr;
+    }
+
+    // Counting sort of the built and the staged nodes by bucket; a later insert of a key replaces
+    // the earlier one
+    void build() override {
+        std::vector<Node> all = std::move(nodes_);
+        all.insert(all.end(), pending_.begin(), pending_.end());
+        pending_ = {};
+        if (all.size() > std::numeric_limits<uint32_t>::max()) {
+            throw std::length_error("CsrChainedHashTable: more nodes than 32-bit offsets can address");
+        }
+
+        std::size_t numBuckets = offsets_.size() - 1;
+        std::vector<uint32_t> counts(numBuckets + 1, 0);
+        for (auto& node : all) counts[indexFor(node.key) + 1]++;
+        std::partial_sum(counts.begin(), counts.end(), counts.begin());
+
+        std::vector<uint32_t> next(counts.begin(), counts.end() - 1);
+        nodes_.assign(all.size(), Node{});
+        for (auto& node : all) nodes_[next[indexFor(node.key)]++] = node;
+        all = {};
+
+        // Drop replaced duplicates, keeping the last occurrence within every bucket
+        uint32_t out = 0;
+        for (std::size_t b = 0; b < numBuckets; b++) {
+            uint32_t begin = out;
+            for (uint32_t i = counts[b]; i < counts[b + 1]; i++) {
+                bool replaced = false;
+                for (uint32_t j = i + 1; j < counts[b + 1] && !replaced; j++) replaced = nodes_[j].key == nodes_[i].key;
+                if (!replaced) nodes_[out++] = nodes_[i];
+            }
+            offsets_[b] = begin;
+        }
+        offsets_[numBuckets] = out;
+        nodes_.resize(out);
+        nodes_.shrink_to_fit();
+    }
+
+private:
+    std::vector<Node> pending_;
+
+    inline std::size_t indexFor(uint64_t key) const {
+        return key & (offsets_.size() - 2);
+    }
+};
+
+// Data Structure #4 - Open addressing hash table: one flat power-of-two array of Node slots,
+// linear probing, doubling once the load factor would exceed maxLoad. Keys are spread with
+// Fibonacci (multiplicative) hashing; the all-ones key marks an empty slot and cannot be stored.
+class OpenAddressingHashTable : public IDataStructure {
+public:
+    static constexpr uint64_t emptyKey = std::numeric_limits<uint64_t>::max();
+
+    std::vector<Node> slots_;
+    explicit OpenAddressingHashTable(std::size_t expectedCount, double max_load = 0.5)
+        : maxLoad_(std::clamp(max_load, 0.05, 0.95))
+    {
+        resize(std::bit_ceil(std::max<std::size_t>(
+            2, static_cast<std::size_t>(std::ceil(expectedCount / maxLoad_)))));
+    }
+
+    inline void insert(uint64_t key, const Node &node) override {
+        if (key == emptyKey) throw std::invalid_argument("OpenAddressingHashTable: the all-ones key marks empty slots");
+        if (static_cast<double>(size_ + 1) > maxLoad_ * static_cast<double>(slots_.size())) {
+            resize(slots_.size() * 2);
+        }
+        Node& slot = probe(key);
+        if (slot.key == emptyKey) ++size_;
+        slot = node;
+        slot.key = key;
+    }
+
+    inline Node* lookup(uint64_t key) override {
+        if (key == emptyKey) return nullptr;
+        Node& slot = probe(key);
+        return slot.key == key ? &slot : nullptr;
+    }
+
+private:
+    double maxLoad_;
+    std::size_t size_ = 0;
+    unsigned shift_ = 63;
+
+    // Slot holding key, or the empty slot that ends its probe sequence
+    inline Node& probe(uint64_t key) {
+        std::size_t mask = slots_.size() - 1;
+        std::size_t i = indexFor(key);
+        while (slots_[i].key != key && slots_[i].key != emptyKey) {
+            i = (i + 1) & mask;
+        }
+        return slots_[i];
+    }
+
+    inline std::size_t indexFor(uint64_t key) const {
+        return static_cast<std::size_t>((key * 0x9e3779b97f4a7c15ull) >> shift_);
+    }
+
+    void resize(std::size_t capacity) {
+        std::vector<Node> old = std::move(slots_);
+        Node empty{};
+        empty.key = emptyKey;
+        slots_.assign(capacity, empty);
+        shift_ = 64 - static_cast<unsigned>(std::countr_zero(capacity));
+        size_ = 0;
+        for (auto& node : old) {
+            if (node.key != emptyKey) insert(node.key, node);
+        }
+    }
+};
+
+
+// Data Structure #5 - Swiss-table style hash table: Node slots in groups of 16 beside an array of
+// 1-byte control tags (empty, or 7 bits of the key's hash). A lookup compares the 16 tags of a
+// group at once with SSE2 and only touches slots whose tag matches; groups are probed
+// triangularly, which visits every group of a power-of-two table.
+class SwissHashTable : public IDataStructure {
+public:
+    static constexpr std::size_t groupWidth = 16;
+    static constexpr uint8_t emptyTag = 0x80;
+
+    std::vector<uint8_t> ctrl_;
+    std::vector<Node> slots_;
+    explicit SwissHashTable(std::size_t expectedCount, double max_load = 0.875)
+        : maxLoad_(std::clamp(max_load, 0.05, 0.95))
+    {
+        resize(std::bit_ceil(std::max<std::size_t>(
+            1, static_cast<std::size_t>(std::ceil(expectedCount / maxLoad_ / groupWidth)))));
+    }
+
+    inline void insert(uint64_t key, const Node &node) override {
+        if (Node* existing = lookup(key)) {
+            *existing = node;
+            existing->key = key;
+            return;
+        }
+        if (static_cast<double>(size_ + 1) > maxLoad_ * static_cast<double>(slots_.size())) {
+            resize(slots_.size() / groupWidth * 2);
+        }
+        uint64_t hash = hashOf(key);
+        std::size_t mask = slots_.size() / groupWidth - 1;
+        std::size_t group = (hash >> shift_) & mask;
+        for (std::size_t step = 1;; step++) {
+            uint32_t empty = matchTag(group, emptyTag);
+            if (empty) {
+                std::size_t i = group * groupWidth + static_cast<std::size_t>(std::countr_zero(empty));
+                ctrl_[i] = tagOf(hash);
+                slots_[i] = node;
+                slots_[i].key = key;
+                ++size_;
+                return;
+            }
+            group = (group + step) & mask;
+        }
+    }
+
+    inline Node* lookup(uint64_t key) override {
+        uint64_t hash = hashOf(key);
+        uint8_t tag = tagOf(hash);
+        std::size_t mask = slots_.size() / groupWidth - 1;
+        std::size_t group = (hash >> shift_) & mask;
+        for (std::size_t step = 1;; step++) {
+            for (uint32_t hits = matchTag(group, tag); hits; hits &= hits - 1) {
+                Node& slot = slots_[group * groupWidth + static_cast<std::size_t>(std::countr_zero(hits))];
+                if (slot.key == key) return &slot;
+            }
+            if (matchTag(group, emptyTag)) return nullptr;
+            group = (group + step) & mask;
+        }
+    }
+
+private:
+    double maxLoad_;
+    std::size_t size_ = 0;
+    unsigned shift_ = 63;
+
+    static inline uint64_t hashOf(uint64_t key) { return key * 0x9e3779b97f4a7c15ull; }
+
+    // The group index takes the top bits of the hash, the tag the 7 bits right below them
+    inline uint8_t tagOf(uint64_t hash) const { return static_cast<uint8_t>((hash >> (shift_ - 7)) & 0x7f); }
+
+    // Bit i set where control byte i of the group equals tag
+    inline uint32_t matchTag(std::size_t group, uint8_t tag) const {
+        __m128i ctrl = _mm_loadu_si128(reinterpret_cast<const __m128i*>(&ctrl_[group * groupWidth]));
+        __m128i match = _mm_cmpeq_epi8(ctrl, _mm_set1_epi8(static_cast<char>(tag)));
+        return static_cast<uint32_t>(_mm_movemask_epi8(match));
+    }
+
+    void resize(std::size_t groups) {
+        std::vector<uint8_t> oldCtrl = std::move(ctrl_);
+        std::vector<Node> oldSlots = std::move(slots_);
+        ctrl_.assign(groups * groupWidth, emptyTag);
+        slots_.assign(groups * groupWidth, Node{});
+        // A single group has no index bits; shift by 63 and let the mask clear the remaining one
+        shift_ = std::min(64 - static_cast<unsigned>(std::countr_zero(groups)), 63u);
+        size_ = 0;
+        for (std::size_t i = 0; i < oldCtrl.size(); i++) {
+            if (oldCtrl[i] != emptyTag) insert(oldSlots[i].key, oldSlots[i]);
+        }
+    }
+};
+
+
+// Data Structure #6 - Bucketized cuckoo hash table: every key lives in one of two buckets of 8
+// keys, each bucket exactly one cache line, with the Node payloads in a parallel array. A lookup
+// compares both key lines with SSE2 without an early exit between them, so the two loads are
+// independent and their misses overlap: at most two key lines plus the payload, whatever the
+// load. Inserts evict along a random walk; when a walk fails the table doubles and records the
+// load it had reached.
+class CuckooHashTable : public IDataStructure {
+public:
+    static constexpr std::size_t bucketWays = 8;
+    static constexpr uint64_t emptyKey = std::numeric_limits<uint64_t>::max();
+    static constexpr unsigned maxKicks = 500;
+
+    struct alignas(64) Bucket {
+        uint64_t keys[bucketWays];
+    };
+
+    std::vector<Bucket> buckets_;
+    std::vector<Node> slots_;
+    explicit CuckooHashTable(std::size_t expectedCount)
+    {
+        resize(std::bit_ceil(std::max<std::size_t>(
+            1, static_cast<std::size_t>(std::ceil(expectedCount / (bucketWays * 0.95))))));
+    }
+
+    inline void insert(uint64_t key, const Node &node) override {
+        if (key == emptyKey) throw std::invalid_argument("CuckooHashTable: the all-ones key marks empty ways");
+        if (Node* existing = lookup(key)) {
+            *existing = node;
+            existing->key = key;
+            return;
+        }
+        uint64_t homeless = key;
+        Node payload = node;
+        payload.key = key;
+        if (place(homeless, payload)) {
+            ++size_;
+            return;
+        }
+        maxLoadReached_ = std::max(maxLoadReached_, load());
+        ++rehashes_;
+        grow(homeless, payload);
+    }
+
+    inline Node* lookup(uint64_t key) override {
+        if (key == emptyKey) return nullptr;
+        std::size_t b1 = bucket1(key);
+        std::size_t b2 = bucket2(key);
+        uint32_t halves = matchHalves(buckets_[b1], key) | (matchHalves(buckets_[b2], key) << 16);
+        uint32_t hits = halves & (halves >> 1) & 0x55555555u;
+        if (!hits) return nullptr;
+        // Which of the two buckets hit is a coin flip, so pick it with a conditional move
+        unsigned way = static_cast<unsigned>(std::countr_zero(hits)) / 2;
+        std::size_t bucket = way < bucketWays ? b1 : b2;
+        return &slots_[bucket * bucketWays + (way & (bucketWays - 1))];
+    }
+
+    inline double load() const { return static_cast<double>(size_) / static_cast<double>(slots_.size()); }
+
+    // Highest load at which an insert found no place and forced a rehash, 0 if that never happened
+    inline double maxLoadReached() const { return maxLoadReached_; }
+    inline uint64_t rehashes() const { return rehashes_; }
+
+private:
+    std::size_t size_ = 0;
+    unsigned shift_ = 63;
+    double maxLoadReached_ = 0;
+    uint64_t rehashes_ = 0;
+    WyRand rng_{0x2545f4914f6cdd1dull};
+
+    inline std::size_t bucket1(uint64_t key) const {
+        return static_cast<std::size_t>((key * 0x9e3779b97f4a7c15ull) >> shift_) & (buckets_.size() - 1);
+    }
+
+    inline std::size_t bucket2(uint64_t key) const {
+        return static_cast<std::size_t>((key * 0xc2b2ae3d27d4eb4full) >> shift_) & (buckets_.size() - 1);
+    }
+
+    // Bits 2w and 2w + 1 set where way w of the bucket holds key. SSE2 has no 64-bit compare, so
+    // the 32-bit halves are compared and packed down to one byte each for a single movemask
+    static inline uint32_t matchHalves(const Bucket& bucket, uint64_t key) {
+        __m128i needle = _mm_set1_epi64x(static_cast<long long>(key));
+        const __m128i* keys = reinterpret_cast<const __m128i*>(bucket.keys);
+        __m128i low = _mm_packs_epi32(_mm_cmpeq_epi32(_mm_load_si128(keys), needle),
+                                      _mm_cmpeq_epi32(_mm_load_si128(keys + 1), needle));
+        __m128i high = _mm_packs_epi32(_mm_cmpeq_epi32(_mm_load_si128(keys + 2), needle),
+                                       _mm_cmpeq_epi32(_mm_load_si128(keys + 3), needle));
+        return static_cast<uint32_t>(_mm_movemask_epi8(_mm_packs_epi16(low, high)));
+    }
+
+    inline bool placeEmpty(std::size_t bucket, uint64_t key, const Node& payload) {
+        for (std::size_t w = 0; w < bucketWays; w++) {
+            if (buckets_[bucket].keys[w] == emptyKey) {
+                buckets_[bucket].keys[w] = key;
+                slots_[bucket * bucketWays + w] = payload;
+                return true;
+            }
+        }
+        return false;
+    }
+
+    // Random-walk insertion; on failure key / payload hold the entry that is left without a place
+    inline bool place(uint64_t& key, Node& payload) {
+        std::size_t from = buckets_.size();
+        for (unsigned kick = 0; kick <= maxKicks; kick++) {
+            std::size_t b1 = bucket1(key);
+            std::size_t b2 = bucket2(key);
+            if (placeEmpty(b1, key, payload) || placeEmpty(b2, key, payload)) return true;
+
+            // Evict from the bucket the entry in hand did not just come from
+            std::size_t victim = from == b1 ? b2 : from == b2 ? b1 : (rng_() & 1 ? b1 : b2);
+            std::size_t way = rng_.below(bucketWays);
+            std::swap(key, buckets_[victim].keys[way]);
+            std::swap(payload, slots_[victim * bucketWays + way]);
+            from = victim;
+        }
+        return false;
+    }
+
+    // Double until every entry (plus the homeless one) finds a place
+    void grow(uint64_t homelessKey, const Node& homeless) {
+        std::vector<Node> entries;
+        entries.reserve(size_ + 1);
+        for (std::size_t i = 0; i < slots_.size(); i++) {
+            if (buckets_[i / bucketWays].keys[i % bucketWays] != emptyKey) entries.push_back(slots_[i]);
+        }
+        entries.push_back(homeless);
+        entries.back().key = homelessKey;
+
+        std::size_t count = buckets_.size() * 2;
+        for (bool placed = false; !placed; count *= 2) {
+            resize(count);
+            placed = true;
+            for (auto& entry : entries) {
+                uint64_t key = entry.key;
+                Node payload = entry;
+                if (!place(key, payload)) { placed = false; break; }
+                ++size_;
+            }
+        }
+    }
+
+    void resize(std::size_t count) {
+        Bucket empty;
+        std::fill(std::begin(empty.keys), std::end(empty.keys), emptyKey);
+        buckets_.assign(count, empty);
+        slots_.assign(count * bucketWays, Node{});
+        shift_ = std::min(64 - static_cast<unsigned>(std::countr_zero(count)), 63u);
+        size_ = 0;
+    }
+};
+
+
+// Log-bucketed (HDR-style) histogram of non-negative integers: exact below 32, above that
+// 32 sub-buckets per power of two, so a reported value is at most ~3% above the true one
+class LatencyHistogram {
+public:
+    static constexpr unsigned sub_bits = 5;
+
+    inline void record(uint64_t value) {
+        counts_[bucketFor(value)]++;
+        count_++;
+        max_ = std::max(max_, value);
+    }
+
+    inline uint64_t count() const { return count_; }
+    inline uint64_t max() const { return max_; }
+
+    // Upper bound of the bucket holding the value at quantile p (0 .. 1)
+    inline uint64_t percentile(double p) const {
+        if (count_ == 0) return 0;
+        uint64_t rank = std::max<uint64_t>(1, static_cast<uint64_t>(std::ceil(p * static_cast<double>(count_))));
+        uint64_t seen = 0;
+        for (size_t b = 0; b < counts_.size(); b++) {
+            seen += counts_[b];
+            if (seen >= rank) return std::min(bucketUpper(b), max_);
+        }
+        return max_;
+    }
+
+private:
+    std::array<uint64_t, (64 - sub_bits + 1) << sub_bits> counts_{};
+    uint64_t count_ = 0;
+    uint64_t max_ = 0;
+
+    static inline size_t bucketFor(uint64_t value) {
+        if (value < (uint64_t(1) << sub_bits)) return value;
+        unsigned shift = 63 - static_cast<unsigned>(__builtin_clzll(value)) - sub_bits;
+        return ((shift + 1) << sub_bits) + ((value >> shift) & ((uint64_t(1) << sub_bits) - 1));
+    }
+
+    static inline uint64_t bucketUpper(size_t bucket) {
+        if (bucket < (size_t(1) << sub_bits)) return bucket;
+        unsigned shift = static_cast<unsigned>(bucket >> sub_bits) - 1;
+        uint64_t mantissa = (bucket & ((size_t(1) << sub_bits) - 1)) | (uint64_t(1) << sub_bits);
+        return (mantissa << shift) + ((uint64_t(1) << shift) - 1);
+    }
+};
+
 
 template <class T> inline void doNotOptimizeAway(T &&datum) {
   asm volatile("" : : "r,m"(datum) : "memory");
 }
 
+// Summary of the repeated passes of one measurement, after outlier rejection
+struct Measurement {
+    double min;
+    double median;
+    double p90;
+    double p99;
+    double mean;
+    double stddev;
+    uint64_t samples;     // passes kept
+    uint64_t outliers;    // passes further than 3.5 scaled MADs (median absolute deviations) from the median
+};
+
+// Bandwidth (MB/s) and latency (cycles per lookup) of one data structure in benchmark_datastructure_stats()
+struct DataStructureResult {
+    std::string name;
+    Measurement bandwidth;
+    Measurement latency;
+};
+
+/**
+   * Reject outliers (MAD-based) from the given per-pass results and summarize the rest.
+   */
+Measurement summarize(std::vector<double> samples);
+
+// Result of one page size in page_size_sweep(); backing differs from requested
+// when the system could not provide the requested pages and we fell back
+struct PageSizeResult {
+    PageSize requested;
+    PageSize backing;
+    uint64_t latency;     // cycles per lookup
+    uint64_t bandwidth;   // MB/s
+};
+
+/**
+   * Set the wall-clock budget (in seconds, default 10) of one call to latency(), bandwidth(),
+   * benchmark_datastructure() and the other single-threaded bandwidth probes. Passes are
+   * repeated until the budget is spent or the 95% confidence interval is within 1% of the mean;
+   * the single-number probes return the median of the passes.
+   */
+void set_time_budget(double seconds);
+
+/**
+   * Return the current time budget of one measurement in seconds.
+   */
+double time_budget();
+
+/**
+   * Set the seed (default 42) every workload generator derives its stream from: random cycles,
+   * shuffles and lookup sequences. Rerunning with the same seed reproduces the same workload.
+   */
+void set_workload_seed(uint64_t seed);
+
+/**
+   * Return the current workload seed, for recording it next to the results.
+   */
+uint64_t workload_seed();
+
+/**
+   * Return the generator of the named workload stream, derived from the workload seed and the name.
+   */
+WyRand workload_rng(std::string_view stream);
+
 /**
    * Return the measured latency of the cache for a given data structure size (in KB)
-   * in cycles per lookup
+   * in cycles per lookup, with the linked list backed by the given page size
+   */
+uint64_t latency(uint64_t size_kb, PageSize page_size = PageDefault);
+
+/**
+   * latency() with the statistics of all passes instead of just their median.
+   */
+Measurement latency_stats(uint64_t size_kb, PageSize page_size = PageDefault);
+
+/**
+   * Link nodes[0 .. count) into one random cycle in place with Sattolo's algorithm, as latency()
+   * does, and number them (data = index). From 64 MB on the nodes are split into 64 residue
+   * classes, built by num_threads threads (0 = every available core) and spliced together in
+   * random order. The chain depends only on count and seed, not on the threads. Returns the head.
+   */
+Node *link_sattolo_cycle(Node *nodes, size_t count, uint64_t seed, unsigned num_threads = 0);
+
+/**
+   * Memory-level parallelism probe: split a data structure of the given size (in KB) into K
+   * independent shuffled cycles and walk all of them in lockstep, for K = 1 .. max_chains (at most 32).
+   * Return the effective latency in ns per miss for every K; where it stops dropping the
+   * line-fill buffers / MSHRs of the level the size lands in are exhausted.
+   signature {ns_k1, ns_k2, ..., ns_kmax}
+   */
+std::vector<double> latency_mlp(uint64_t size_kb, unsigned max_chains = 32);
+
+// Latency curve of tlb_latency() over a sweep of working sets and the TLB sizes read off its knees
+struct TlbProfile {
+    std::vector<uint64_t> pages;        // working set sizes probed, in 4 KB pages
+    std::vector<double> latency;        // cycles per hop, one line per page
+    std::vector<double> cache_latency;  // cycles per hop over the same number of lines packed contiguously
+    uint64_t l1_dtlb_entries;           // largest working set before the first knee, 0 if none was found
+    uint64_t stlb_entries;              // largest working set before the second knee, 0 if none was found
+};
+
+/**
+   * Return the measured latency of a pointer chase where every hop lands on a different 4 KB page
+   * (at a random cache line within it) over a working set of num_pages pages, in cycles per hop.
+   */
+double tlb_latency(uint64_t num_pages);
+
+/**
+   * Sweep tlb_latency() from 4 pages to max_pages (four points per doubling). The same number of
+   * lines is also chased packed into contiguous memory; the difference between both curves is
+   * the translation cost alone, and the L1 dTLB and STLB entry counts are read off its knees.
+   */
+TlbProfile tlb_profile(uint64_t max_pages = 16384);
+
+// One access pattern of prefetch_sweep()
+struct PrefetchResult {
+    uint64_t stride;        // distance between consecutive accesses, in lines
+    bool backward;          // walk from the end of the array to its start
+    bool page_offset;       // line index rotated by a random offset inside every 4 KB page
+    double strided_ns;      // ns per access following the pattern
+    double random_ns;       // ns per access visiting the same lines in random order
+    double saving;          // 1 - strided_ns / random_ns, share of the latency the prefetchers hide
+};
+
+/**
+   * Walk a Node array of the given size (in KB) at strides of 1, 2, 4, ... 64 lines, forward and
+   * backward, with and without a random offset inside each page. Every access is a dependent load,
+   * so whatever is faster than visiting the same lines in random order is the prefetchers' work.
+   * Run it with a size inside each cache level (see cache_hierarchy()) to see what they save there.
+   */
+std::vector<PrefetchResult> prefetch_sweep(uint64_t size_kb);
+
+/**
+   * Print the results of prefetch_sweep() as a table, one row per access pattern.
+   */
+void print_prefetch_sweep(std::ostream& out, const std::vector<PrefetchResult>& results);
+
+/**
+   * Visit order of prefetch_sweep() over size lines: all lines at the given stride (0, s, 2s, ...,
+   * then 1, 1 + s, ...), optionally reversed and with the line index rotated by a random offset
+   * inside every 4 KB page (within the lines a partial last page has). A permutation of 0 .. size-1.
    */
-uint64_t latency(uint64_t size_kb);
+std::vector<size_t> strided_permutation(size_t size, uint64_t stride, bool backward, bool page_offset,
+                                        WyRand& rng);
+
+// One level of the memory hierarchy as reported by cache_hierarchy()
+struct CacheLevel {
+    unsigned level;           // 1, 2, 3, ... ; the last entry is main memory
+    std::string type;         // "Data", "Unified" or "Memory"
+    uint64_t size_kb;         // capacity reported by sysfs, 0 if unknown
+    uint64_t detected_kb;     // capacity read off the latency curve, 0 if no knee was found
+    double latency_cycles;    // median latency on the level's plateau
+    double latency_ns;
+    uint64_t bandwidth;       // full-line read bandwidth (widest SIMD kernel) in MB/s
+};
+
+/**
+   * Read the data and unified caches of cpu0 from /sys/devices/system/cpu/cpu0/cache, run a
+   * logarithmic latency sweep (four points per doubling, 4 KB up to four times the last level)
+   * and detect where the curve bends. Return one row per cache level plus one for main memory.
+   * Without sysfs the levels are derived from the detected knees alone.
+   */
+std::vector<CacheLevel> cache_hierarchy();
+
+/**
+   * Print the rows of cache_hierarchy() as a table.
+   */
+void print_cache_hierarchy(std::ostream& out, const std::vector<CacheLevel>& levels);
+
+/**
+   * Return the indices of the last point before each step up in a latency curve. A step starts once
+   * two consecutive points lie more than rise (relative) plus min_step (absolute) above the current
+   * plateau, and ends once the curve levels off again.
+   */
+std::vector<size_t> detect_knees(const std::vector<double>& ys, double rise = 0.25, double min_step = 0);
+
+/**
+   * Parse a sysfs cache size ("48K", "2048K", "105M") into KB; a number without suffix is bytes.
+   * Returns 0 if the string does not start with a number.
+   */
+uint64_t parse_cache_size_kb(const std::string& size);
 
 
 /**
    * Return the measured bandwidth of the cache for a given data structure size (in KB)
-   * in MB/s per lookup (rounded to an integer).
+   * in MB/s per lookup (rounded to an integer), with the array backed by the given page size
+   */
+uint64_t bandwidth(uint64_t size_kb, PageSize page_size = PageDefault);
+
+/**
+   * bandwidth() with the statistics of all passes instead of just their median.
+   */
+Measurement bandwidth_stats(uint64_t size_kb, PageSize page_size = PageDefault);
+
+/**
+   * Run latency() and bandwidth() for a given data structure size (in KB) with 4K pages,
+   * transparent huge pages, 2M pages and 1G pages, falling back to smaller pages where
+   * the larger ones are not available.
+   signature {Page4K, PageTHP, Page2M, Page1G}
+   */
+std::vector<PageSizeResult> page_size_sweep(uint64_t size_kb);
+
+// Latency and bandwidth for every pair of NUMA nodes; row = node the thread runs on,
+// column = node the memory lives on. Pairs without CPUs or memory are left at 0.
+struct NumaMatrix {
+    unsigned nodes;
+    std::vector<uint64_t> latency;     // cycles per lookup, nodes x nodes, row-major
+    std::vector<uint64_t> bandwidth;   // MB/s, nodes x nodes, row-major
+};
+
+/**
+   * Run latency() and bandwidth() for a given data structure size (in KB) for every pair of
+   * (cpu node, memory node): the thread is bound to the cpu node, the linked list and the array
+   * to the memory node. On a machine without NUMA the result is a single 1x1 entry.
+   */
+NumaMatrix numa_matrix(uint64_t size_kb);
+
+/**
+   * Print both matrices of numa_matrix() as tables.
+   */
+void print_numa_matrix(std::ostream& out, const NumaMatrix& matrix);
+
+// One point of the loaded-latency curve
+struct LoadedLatencyPoint {
+    uint64_t delay;           // pause instructions every load thread spins after each 8 lines it reads
+    uint64_t bandwidth;       // MB/s read by all load threads together, 0 for the idle point
+    double latency_ns;        // pointer-chase latency seen meanwhile
+    double latency_cycles;
+};
+
+/**
+   * Loaded latency (in the spirit of Intel MLC): one pinned thread chases a randomly linked list of
+   * the given size (in KB) while load_threads other pinned threads stream over an array of the same
+   * size, throttled by spinning delay pause instructions after every 8 lines.
+   * Return the idle point (no load threads) followed by one point per delay, from the largest delay
+   * (lightest load) to the smallest (heaviest load).
+   */
+std::vector<LoadedLatencyPoint> loaded_latency(uint64_t size_kb, unsigned load_threads,
+                                               const std::vector<uint64_t>& delays = {6400, 3200, 1600, 800, 400, 200, 100, 50, 0});
+
+/**
+   * Print the points of loaded_latency() as a table, one row per point.
    */
-uint64_t bandwidth(uint64_t size_kb);
+void print_loaded_latency(std::ostream& out, const std::vector<LoadedLatencyPoint>& points);
 
 /**
-   * Return the bandwidths and latencies of 4 distinct data structures:
-   DirectAccessArray
-   BinarySearch
-   ChainedHashTable with maxLoad = 1
-   ChainedHashTable with maxLoad = 16
-   signature {bw_1, bw_2, bw_3, bw_4, lat_1, lat_2, lat_3, lat_4}
+   * Return the bandwidth of reading a data structure of the given size (in KB) with
+   * num_threads threads, each pinned to its own core and streaming over its own slice.
+   * All threads start behind a barrier; the combined figure covers the time from the
+   * first thread starting until the last one finishing. Passes are repeated within the time
+   * budget and every figure is the median over them.
+   * in MB/s (rounded to integers), num_threads = 0 uses every core we may run on
+   signature {bw_combined, bw_thread_0, ..., bw_thread_n-1}
+   */
+std::vector<uint64_t> bandwidth_mt(uint64_t size_kb, unsigned num_threads);
+
+// One-way cache-line transfer latency between every pair of cores we may run on
+struct CoreToCoreMatrix {
+    std::vector<unsigned> cores;         // cpu ids of the rows / columns
+    std::vector<double> latency_ns;      // cores x cores, row-major, 0 on the diagonal
+    std::vector<double> latency_cycles;
+};
+
+/**
+   * Bounce one Node-sized cache line between two threads pinned to core i (ping) and core j (pong)
+   * for every ordered pair of cores: ping writes an odd sequence number, pong answers with the next
+   * even one. Half the median round trip is the one-way transfer latency.
+   */
+CoreToCoreMatrix core_to_core_matrix();
+
+/**
+   * Print both matrices of core_to_core_matrix() as tables.
+   */
+void print_core_to_core_matrix(std::ostream& out, const CoreToCoreMatrix& matrix);
+
+/**
+   * Return the bandwidth of a STREAM kernel whose arrays together occupy the given size (in KB).
+   * Bytes moved count every read, every write and the write-allocate read of the destination
+   * line (Copy/Scale: 3 x 8 bytes per element, Add/Triad: 4 x 8 bytes per element).
+   * in MB/s (rounded to an integer).
+   */
+uint64_t stream_bandwidth(uint64_t size_kb, StreamKernel kernel);
+
+/**
+   * Return whether the CPU (and OS) we run on support the given read kernel, checked via CPUID.
+   */
+bool read_kernel_supported(ReadKernel kernel);
+
+/**
+   * Return the widest read kernel supported by the CPU we run on.
+   */
+ReadKernel best_read_kernel();
+
+/**
+   * Return the measured bandwidth of reading every byte of a data structure of the given
+   * size (in KB) with the given kernel, in MB/s (rounded to an integer).
+   * Returns 0 if the kernel is not supported on this CPU.
+   */
+uint64_t bandwidth_simd(uint64_t size_kb, ReadKernel kernel);
+
+/**
+   * Return the full-line read bandwidth of every kernel for a data structure of the given size (in KB)
+   * in MB/s, 0 for kernels this CPU does not support
+   signature {bw_scalar, bw_avx2, bw_avx512}
+   */
+std::vector<uint64_t> bandwidth_per_isa(uint64_t size_kb);
+
+/**
+   * Return the measured bandwidth of overwriting a data structure of the given size (in KB)
+   * with the given store kernel, in MB/s of bytes written (rounded to an integer).
+   */
+uint64_t write_bandwidth(uint64_t size_kb, WriteKernel kernel);
+
+/**
+   * Run write_bandwidth() with regular and non-temporal stores over the given sizes (in KB)
+   * and return the smallest size from which on non-temporal stores win at every larger size,
+   * 0 if they never do.
+   */
+uint64_t nt_store_crossover(const std::vector<uint64_t>& sizes_kb);
+
+/**
+   * Return the combined throughput of num_threads threads, each pinned to its own core, hammering
+   * the counters of the given kernel for the time budget. Private counters are bumped with plain
+   * (relaxed load + store) increments, the shared atomic with the kernel's read-modify-write.
+   * in operations/s (successful increments for CompareExchange), num_threads = 0 uses every core
+   */
+uint64_t contended_throughput(ContentionKernel kernel, unsigned num_threads);
+
+/**
+   * Run contended_throughput() for 1 .. max_threads threads, splitting the time budget evenly.
+   * in operations/s, max_threads = 0 uses every core we may run on
+   signature {ops_1_thread, ops_2_threads, ..., ops_max_threads}
+   */
+std::vector<uint64_t> contention_scaling(ContentionKernel kernel, unsigned max_threads = 0);
+
+/**
+   * Return the bandwidths and latencies of these data structures:
+   1 DirectAccessArray
+   2 BinarySearch
+   3 ChainedHashTable with maxLoad = 1
+   4 ChainedHashTable with maxLoad = 16
+   5 OpenAddressingHashTable with max load factor 0.5
+   6 SwissHashTable with max load factor 0.875
+   7 CuckooHashTable (2 hash functions, 8-way line-sized buckets)
+   8 CsrChainedHashTable with maxLoad = 1
+   9 CsrChainedHashTable with maxLoad = 16
+   10 EytzingerSearch
+   11 BranchlessBinarySearch
+   12 STree (8-key nodes, widest SIMD compare the CPU supports)
+   The first four keep their original positions, every further structure appends a pair
+   signature {bw_1, bw_2, bw_3, bw_4, lat_1, lat_2, lat_3, lat_4, bw_5, lat_5, ...}
    */
 std::vector<uint64_t> benchmark_datastructure(uint64_t size_kb, AccessPattern access_pattern);
 
+/**
+   * benchmark_datastructure() with the statistics of all passes, one entry per data structure
+   * in the same order.
+   */
+std::vector<DataStructureResult> benchmark_datastructure_stats(uint64_t size_kb, AccessPattern access_pattern);
+
+// Per-lookup latency distribution of one data structure in benchmark_datastructure_tail(),
+// in TSC ticks with the timer overhead already subtracted
+struct LookupTail {
+    std::string name;
+    uint64_t p50;
+    uint64_t p99;
+    uint64_t p999;
+    uint64_t max;
+    uint64_t overhead;    // ticks of an empty timed region, subtracted from every sample
+    uint64_t samples;
+};
+
+/**
+   * Time every sample_every-th lookup of benchmark_datastructure()'s workload individually with
+   * lfence/rdtsc ... rdtscp/lfence, collect the samples in a log-bucketed histogram and return
+   * p50/p99/p99.9/max per data structure (same order as benchmark_datastructure_stats()).
+   */
+std::vector<LookupTail> benchmark_datastructure_tail(uint64_t size_kb, AccessPattern access_pattern,
+                                                     uint64_t sample_every = 16);
+
+// Hardware counters per lookup of one data structure in benchmark_datastructure_counters();
+// a counter the kernel does not let us open is reported as -1
+struct LookupCounters {
+    std::string name;
+    double cycles;          // per lookup, TSC ticks if the cycles counter is unavailable
+    double branch_misses;   // per lookup
+    double instructions;    // per lookup
+    double llc_misses;      // per lookup
+};
+
+/**
+   * Run benchmark_datastructure()'s lookup workload once more per data structure (same order) under
+   * PerfEvent and return cycles, branch-misses, instructions and LLC-misses per lookup, so the
+   * effect of branch-free searches and cache-friendly layouts shows up in the counters as well as
+   * in the cycles.
+   */
+std::vector<LookupCounters> benchmark_datastructure_counters(uint64_t size_kb, AccessPattern access_pattern);
+
+// Build speed of one data structure in insert_throughput()
+struct InsertResult {
+    std::string name;
+    uint64_t inserts_per_second;
+};
+
+/**
+   * Time populating each data structure of benchmark_datastructure() (same order) with the nodes
+   * of a data structure of the given size (in KB), in ascending key order.
+   */
+std::vector<InsertResult> insert_throughput(uint64_t size_kb);
+
+/**
+   * Fill a CuckooHashTable sized for a data structure of the given size (in KB) with random keys
+   * until the first insert fails to find a place, and return the load factor reached (0 .. 1).
+   */
+double cuckoo_max_load(uint64_t size_kb);
+
 
 
 
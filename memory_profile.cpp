@@ -0,0 +1,97 @@
+#include "Benchmarking.hpp"
+#include <iostream>
+#include <iomanip>
+#include <cstdlib>
+#include <vector>
+#include <thread>
+
+// Memory subsystem profile of this machine
+// Usage: benchmark_memory_profile [seconds]   (time budget per probe, default 10)
+
+int main(int argc, char **argv) {
+    if (argc > 1) {
+        set_time_budget(std::atof(argv[1]));
+    }
+
+    std::cout << "Memory profile (budget " << time_budget() << " s per probe)" << std::endl;
+
+    // Cache levels from sysfs next to the ones read off the latency curve
+    std::cout << std::endl << "CACHE HIERARCHY:" << std::endl;
+    std::vector<CacheLevel> levels = cache_hierarchy();
+    print_cache_hierarchy(std::cout, levels);
+
+    // What the prefetchers save inside every level: half its capacity, four times the last cache for DRAM
+    uint64_t previous_kb = 0;
+    for (auto& level : levels) {
+        uint64_t capacity_kb = level.detected_kb ? level.detected_kb : level.size_kb;
+        uint64_t size_kb = level.type == "Memory" ? 4 * previous_kb : capacity_kb / 2;
+        previous_kb = capacity_kb;
+        if (size_kb == 0) continue;
+        std::cout << std::endl << "PREFETCHERS, level " << level.level << " (" << level.type << ", "
+                  << size_kb << " KB):" << std::endl;
+        print_prefetch_sweep(std::cout, prefetch_sweep(size_kb));
+    }
+
+    // Read bandwidth per SIMD width: L1, L2, L3 and main memory sized working sets
+    std::cout << std::endl << "READ BANDWIDTH PER ISA (MB/s, 0 = unsupported):" << std::endl;
+    std::cout << std::setw(12) << "size_kb" << std::setw(12) << "scalar"
+              << std::setw(12) << "avx2" << std::setw(12) << "avx512" << std::endl;
+    for (uint64_t size_kb : {16, 256, 4096, 262144}) {
+        std::cout << std::setw(12) << size_kb;
+        for (uint64_t bw : bandwidth_per_isa(size_kb)) std::cout << std::setw(12) << bw;
+        std::cout << std::endl;
+    }
+
+    // TLB reach: one line per 4 KB page against the same lines packed, entry counts off the knees
+    TlbProfile tlb = tlb_profile();
+    std::cout << std::endl << "TLB REACH (cycles per hop):" << std::endl;
+    std::cout << std::setw(10) << "pages" << std::setw(12) << "paged" << std::setw(12) << "packed" << std::endl;
+    for (size_t i = 0; i < tlb.pages.size(); i++) {
+        std::cout << std::setw(10) << tlb.pages[i] << std::fixed << std::setprecision(1)
+                  << std::setw(12) << tlb.latency[i] << std::setw(12) << tlb.cache_latency[i]
+                  << std::defaultfloat << std::endl;
+    }
+    std::cout << "L1 dTLB entries: " << tlb.l1_dtlb_entries << ", STLB entries: " << tlb.stlb_entries
+              << " (0 = no knee found)" << std::endl;
+
+    // Page sizes: the latency gap between 4K and huge pages is the page walk cost
+    const char *page_names[] = {"default", "4K", "THP", "2M", "1G"};
+    std::cout << std::endl << "PAGE SIZES (256 MB):" << std::endl;
+    std::cout << std::setw(10) << "requested" << std::setw(10) << "backing"
+              << std::setw(10) << "cycles" << std::setw(12) << "MB/s" << std::endl;
+    for (auto& r : page_size_sweep(262144)) {
+        std::cout << std::setw(10) << page_names[r.requested] << std::setw(10) << page_names[r.backing]
+                  << std::setw(10) << r.latency << std::setw(12) << r.bandwidth << std::endl;
+    }
+
+    // Misses in flight: effective latency with K independent pointer chases in DRAM
+    std::cout << std::endl << "MEMORY-LEVEL PARALLELISM (256 MB, ns per miss):" << std::endl;
+    std::cout << std::setw(8) << "chains" << std::setw(12) << "ns" << std::endl;
+    std::vector<double> mlp = latency_mlp(262144);
+    for (size_t k = 0; k < mlp.size(); k++) {
+        std::cout << std::setw(8) << k + 1 << std::setw(12) << std::fixed << std::setprecision(2)
+                  << mlp[k] << std::defaultfloat << std::endl;
+    }
+
+    // Latency and bandwidth between every pair of NUMA nodes, in DRAM
+    std::cout << std::endl << "NUMA MATRIX (64 MB):" << std::endl;
+    print_numa_matrix(std::cout, numa_matrix(65536));
+
+    // Latency under increasing bandwidth pressure from all other cores
+    unsigned load_threads = std::max(std::thread::hardware_concurrency(), 2u) - 1;
+    std::cout << std::endl << "LOADED LATENCY (256 MB, " << load_threads << " load threads):" << std::endl;
+    print_loaded_latency(std::cout, loaded_latency(262144, load_threads));
+
+    // Shared-line contention: operations/s per kernel for 1 .. all cores
+    const char *contention_names[] = {"packed", "padded", "fetch_add", "cas", "exchange"};
+    std::cout << std::endl << "CONTENTION SCALING (Mops/s by thread count):" << std::endl;
+    for (ContentionKernel kernel : {PackedCounters, PaddedCounters, FetchAdd, CompareExchange, Exchange}) {
+        std::cout << std::setw(10) << contention_names[kernel];
+        for (uint64_t ops : contention_scaling(kernel)) {
+            std::cout << std::setw(10) << std::fixed << std::setprecision(1) << ops / 1e6 << std::defaultfloat;
+        }
+        std::cout << std::endl;
+    }
+
+    return 0;
+}
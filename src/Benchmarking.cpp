@@ -6,71 +6,776 @@ constexpr size_t cache_line = 64;
 static_assert(sizeof(Node) == cache_line);
 static_assert(alignof(Node) == cache_line);
 
-static int64_t seconds = 10;
+// Time budget of one measurement in seconds, see set_time_budget()
+static double seconds = 10;
 
+// A measurement stops early once the 95% confidence interval of its passes is within 1% of their mean
+static constexpr double target_ci = 0.01;
+static constexpr size_t min_passes = 10;
 
-uint64_t latency(uint64_t size_kb) {
+
+void set_time_budget(double budget_seconds) { seconds = budget_seconds; }
+
+double time_budget() { return seconds; }
+
+// Seed of every workload generator, see set_workload_seed()
+static uint64_t global_seed = 42;
+
+void set_workload_seed(uint64_t seed) { global_seed = seed; }
+
+uint64_t workload_seed() { return global_seed; }
+
+WyRand workload_rng(std::string_view stream) {
+  // FNV-1a of the stream name, mixed with the seed through one wyrand step
+  uint64_t hash = 0xcbf29ce484222325ull;
+  for (char c : stream) {
+    hash = (hash ^ static_cast<unsigned char>(c)) * 0x100000001b3ull;
+  }
+  WyRand mixer{global_seed ^ hash};
+  return WyRand{mixer()};
+}
+
+
+// Adaptive iteration control: pass(iterations) runs the measured loop iterations times and returns
+// its result (per lookup, per byte, ...). The iteration count is scaled up until one pass takes a
+// fiftieth of the budget; then passes are repeated until the budget is spent or the confidence
+// interval is tight enough. Returns the result of every measured pass.
+template <class F>
+static std::vector<double> run_adaptive(F&& pass, double budget = seconds) {
+  using clock = std::chrono::steady_clock;
+  auto begin = clock::now();
+  auto since = [](clock::time_point t) { return std::chrono::duration<double>(clock::now() - t).count(); };
+
+  // Calibration, doubles as warm-up. A single pass that already spends the whole budget is the result.
+  uint64_t iterations = 1;
+  for (;;) {
+    auto start = clock::now();
+    double sample = pass(iterations);
+    double pass_seconds = since(start);
+    if (pass_seconds >= budget) return {sample};
+    if (pass_seconds >= budget / 50 || since(begin) >= budget / 4) break;
+    double scale = pass_seconds > 0 ? budget / 50 / pass_seconds : 1024;
+    iterations *= static_cast<uint64_t>(std::clamp(scale, 2.0, 1024.0));
+  }
+
+  std::vector<double> samples;
+  double sum = 0, sum_sq = 0;
+  for (;;) {
+    double sample = pass(iterations);
+    samples.push_back(sample);
+    sum += sample;
+    sum_sq += sample * sample;
+
+    double n = static_cast<double>(samples.size());
+    double mean = sum / n;
+    double variance = n > 1 ? std::max(sum_sq - n * mean * mean, 0.0) / (n - 1) : 0;
+    double half_width = 1.96 * std::sqrt(variance / n);
+    if (since(begin) >= budget) break;
+    if (samples.size() >= min_passes && half_width <= target_ci * std::abs(mean)) break;
+  }
+  return samples;
+}
+
+Measurement summarize(std::vector<double> samples) {
+  Measurement m{};
+  if (samples.empty()) return m;
+
+  auto percentile = [](const std::vector<double>& sorted, double p) {
+    double rank = p * static_cast<double>(sorted.size() - 1);
+    size_t lower = static_cast<size_t>(rank);
+    size_t upper = std::min(lower + 1, sorted.size() - 1);
+    return sorted[lower] + (sorted[upper] - sorted[lower]) * (rank - static_cast<double>(lower));
+  };
+
+  // Outlier rejection: drop everything further than 3.5 scaled MADs from the median
+  std::sort(samples.begin(), samples.end());
+  double median = percentile(samples, 0.5);
+  std::vector<double> deviations(samples.size());
+  std::transform(samples.begin(), samples.end(), deviations.begin(), [&](double x) { return std::abs(x - median); });
+  std::sort(deviations.begin(), deviations.end());
+  double mad = 1.4826 * percentile(deviations, 0.5);
+  // Quantized timings often repeat exactly and give MAD == 0; floor it at 1% of the median so a
+  // lone spike among identical passes is still rejected
+  mad = std::max(mad, 0.01 * std::abs(median));
+
+  std::vector<double> kept;
+  for (double x : samples) {
+    if (std::abs(x - median) <= 3.5 * mad) kept.push_back(x);
+  }
+
+  double n = static_cast<double>(kept.size());
+  m.samples = kept.size();
+  m.outliers = samples.size() - kept.size();
+  m.min = kept.front();
+  m.median = percentile(kept, 0.5);
+  m.p90 = percentile(kept, 0.9);
+  m.p99 = percentile(kept, 0.99);
+  m.mean = std::accumulate(kept.begin(), kept.end(), 0.0) / n;
+  double sum_sq = 0;
+  for (double x : kept) sum_sq += (x - m.mean) * (x - m.mean);
+  m.stddev = kept.size() > 1 ? std::sqrt(sum_sq / (n - 1)) : 0;
+  return m;
+}
+
+
+// Whether the perf counters can be opened at all (VMs, strict perf_event_paranoid). Probed once,
+// so an unavailable PMU costs one "Error opening counter" line instead of one per timed region.
+// PerfEvent drops all its events when one of them fails to open.
+static bool perf_available() {
+  static const bool available = !PerfEvent().events.empty();
+  return available;
+}
+
+// Cycle counter for a measured region: core cycles from PerfEvent, or TSC ticks when the
+// perf counters are unavailable
+struct CycleTimer {
+  std::optional<PerfEvent> e;
+  uint64_t tsc_start = 0;
+  uint64_t tsc_end = 0;
+  std::chrono::steady_clock::time_point clock_start, clock_end;
+
+  CycleTimer() {
+    if (perf_available()) e.emplace();
+  }
+
+  void start() {
+    if (e) e->startCounters();
+    clock_start = std::chrono::steady_clock::now();
+    tsc_start = __rdtsc();
+  }
+
+  void stop() {
+    tsc_end = __rdtsc();
+    clock_end = std::chrono::steady_clock::now();
+    if (e) e->stopCounters();
+  }
+
+  // Value of the named PerfEvent counter over the region, -1 if it is unavailable
+  double counter(const std::string& name) { return e ? e->getCounter(name) : -1; }
+
+  double cycles() {
+    double cycles = counter("cycles");
+    return cycles >= 0 ? cycles : static_cast<double>(tsc_end - tsc_start);
+  }
+
+  double ns() { return std::chrono::duration<double, std::nano>(clock_end - clock_start).count(); }
+};
+
+
+// Node buffer backed by the requested page size. Explicit huge pages fall back to
+// transparent huge pages and those to regular pages when the system cannot provide them.
+// A numa_node >= 0 binds the (not yet touched) pages to that node, like numa_alloc_onnode.
+class NodeBuffer {
+public:
+  NodeBuffer(size_t count, PageSize page_size, int numa_node = -1) : count_(count) {
+    backing_ = page_size;
+    if (backing_ == Page1G && !map(size_t(1) << 30, MAP_HUGETLB | (30 << MAP_HUGE_SHIFT))) {
+      std::cerr << "1G pages not available, falling back to 2M pages" << std::endl;
+      backing_ = Page2M;
+    }
+    if (backing_ == Page2M && !map(size_t(2) << 20, MAP_HUGETLB | (21 << MAP_HUGE_SHIFT))) {
+      std::cerr << "2M pages not available, falling back to transparent huge pages" << std::endl;
+      backing_ = PageTHP;
+    }
+    if (backing_ == PageTHP && !thp_available()) {
+      std::cerr << "Transparent huge pages disabled, falling back to 4K pages" << std::endl;
+      backing_ = Page4K;
+    }
+    if (!nodes_ && !map(backing_ == PageTHP ? size_t(2) << 20 : 4096, 0)) {
+      throw std::bad_alloc();
+    }
+    if (backing_ == PageTHP) madvise(nodes_, bytes_, MADV_HUGEPAGE);
+    if (backing_ == Page4K) madvise(nodes_, bytes_, MADV_NOHUGEPAGE);
+    if (numa_node >= 0 && numa_available() >= 0) numa_tonode_memory(nodes_, bytes_, numa_node);
+  }
+
+  ~NodeBuffer() {
+    if (nodes_) munmap(nodes_, bytes_);
+  }
+
+  NodeBuffer(const NodeBuffer &) = delete;
+  NodeBuffer &operator=(const NodeBuffer &) = delete;
+
+  Node *data() { return nodes_; }
+  size_t size() const { return count_; }
+  PageSize backing() const { return backing_; }
+  Node &operator[](size_t i) { return nodes_[i]; }
+
+private:
+  Node *nodes_ = nullptr;
+  size_t count_;
+  size_t bytes_ = 0;
+  PageSize backing_;
+
+  // Anonymous mappings are zero-filled, which value-initializes the (trivial) nodes. Hugetlb
+  // mappings come back page-aligned; a plain mapping meant for THP only gets 4K alignment, so it
+  // is over-allocated by one huge page and trimmed to start on a page_bytes boundary
+  bool map(size_t page_bytes, int flags) {
+    size_t bytes = std::max<size_t>(count_ * sizeof(Node), 1);
+    bytes = (bytes + page_bytes - 1) / page_bytes * page_bytes;
+    size_t slack = (flags & MAP_HUGETLB) || page_bytes <= 4096 ? 0 : page_bytes;
+    void *p = mmap(nullptr, bytes + slack, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS | flags, -1, 0);
+    if (p == MAP_FAILED) return false;
+    if (slack) {
+      uintptr_t base = reinterpret_cast<uintptr_t>(p);
+      uintptr_t aligned = (base + page_bytes - 1) & ~(uintptr_t(page_bytes) - 1);
+      if (aligned > base) munmap(p, aligned - base);
+      if (base + slack > aligned) munmap(reinterpret_cast<void *>(aligned + bytes), base + slack - aligned);
+      p = reinterpret_cast<void *>(aligned);
+    }
+    nodes_ = static_cast<Node *>(p);
+    bytes_ = bytes;
+    return true;
+  }
+
+  static bool thp_available() {
+    std::ifstream f("/sys/kernel/mm/transparent_hugepage/enabled");
+    std::string policy;
+    std::getline(f, policy);
+    return f && policy.find("[never]") == std::string::npos;
+  }
+};
+
+
+// CPUs this process may run on (respects numactl / taskset restrictions)
+static std::vector<unsigned> available_cores() {
+  std::vector<unsigned> cores;
+  cpu_set_t set;
+  CPU_ZERO(&set);
+  if (sched_getaffinity(0, sizeof(set), &set) == 0) {
+    for (unsigned cpu = 0; cpu < CPU_SETSIZE; cpu++) {
+      if (CPU_ISSET(cpu, &set)) cores.push_back(cpu);
+    }
+  }
+  if (cores.empty()) cores.push_back(0);
+  return cores;
+}
+
+Node *link_sattolo_cycle(Node *nodes, size_t count, uint64_t seed, unsigned num_threads) {
+  if (count == 0) return nullptr;
+  // The class count depends on the size alone, so a seed gives the same chain however many
+  // cores the process is bound to; only the number of builder threads follows the binding
+  constexpr size_t parallel_threshold = size_t(1) << 20; // nodes, i.e. 64 MB
+  constexpr size_t parallel_classes = 64;
+  size_t num_classes = count >= parallel_threshold ? parallel_classes : 1;
+  if (num_threads == 0) num_threads = static_cast<unsigned>(available_cores().size());
+  num_threads = static_cast<unsigned>(std::min<size_t>(num_threads, num_classes));
+
+  if (num_classes > 1) {
+    // Fault every page in from the calling thread first, so the builders' scattered writes do not
+    // decide where the pages live and the caller's pinning / --membind placement holds
+    constexpr size_t nodes_per_page = 4096 / sizeof(Node);
+    for (size_t i = 0; i < count; i += nodes_per_page) nodes[i].data = 0;
+  }
+
+  auto build = [&](size_t c) {
+    WyRand rng{seed + c * 0x9e3779b97f4a7c15ull};
+    size_t members = (count - c + num_classes - 1) / num_classes; // nodes c, c + T, c + 2T, ...
+    for (size_t k = 0; k < members; k++) {
+      Node &node = nodes[k * num_classes + c];
+      node.data = k * num_classes + c;
+      node.next = &node;
+    }
+    // Starting from the identity, swapping every slot with a random *earlier* one yields a single cycle
+    for (size_t k = members - 1; k > 0; k--) {
+      std::swap(nodes[k * num_classes + c].next, nodes[rng.below(k) * num_classes + c].next);
+    }
+  };
+
+  if (num_classes == 1) {
+    build(0);
+    return &nodes[0];
+  }
+
+  // Classes go round-robin to the builders, each class uses its own generator
+  std::vector<std::thread> threads;
+  for (unsigned t = 0; t < num_threads; t++) {
+    threads.emplace_back([&, t] {
+      for (size_t c = t; c < num_classes; c += num_threads) build(c);
+    });
+  }
+  for (auto& thread : threads) {
+    thread.join();
+  }
+
+  // Cut every class cycle behind its first node and chain the resulting paths in random order
+  WyRand rng{seed ^ 0x5851f42d4c957f2dull};
+  std::vector<size_t> classes(num_classes);
+  std::iota(classes.begin(), classes.end(), 0);
+  for (size_t i = num_classes - 1; i > 0; i--) {
+    std::swap(classes[i], classes[rng.below(i + 1)]);
+  }
+  std::vector<Node *> successors(num_classes);
+  for (size_t c = 0; c < num_classes; c++) {
+    successors[c] = nodes[c].next;
+  }
+  for (size_t i = 0; i < num_classes; i++) {
+    nodes[classes[i]].next = successors[classes[(i + 1) % num_classes]];
+  }
+  return &nodes[classes[0]];
+}
+
+// Latency of a randomly linked list over the given buffer, in cycles per lookup
+static Measurement latency_on(NodeBuffer& linked_list) {
+  // 1. Generate dataset
+
+  uint64_t size = linked_list.size();
+  uint64_t seed = workload_rng("latency")();
+
+
+  // 2. Initialize data structure: one random cycle through all nodes, built in place
+
+  Node *current = link_sattolo_cycle(linked_list.data(), size, seed, 0);
+
+
+  // 3. Measure data structure
+
+  // Warm-up phase: traverse once to load into cache if it fits
+  for (size_t i = 0; i < size; i++) {
+    current = current->next;
+  }
+  doNotOptimizeAway(current);
+
+  // Actual measurement: traverse the list as often as the time budget allows
+  auto pass = [&](uint64_t num_iterations) {
+    CycleTimer timer;
+    timer.start();
+
+    for (size_t iter = 0; iter < num_iterations; iter++) {
+      for (size_t i = 0; i < size; i++) {
+        current = current->next;
+      }
+    }
+    doNotOptimizeAway(current);
+
+    timer.stop();
+
+    uint64_t total_lookups = num_iterations * size;
+    return timer.cycles() / static_cast<double>(total_lookups);
+  };
+
+  return summarize(run_adaptive(pass)); // Latency in Processor Clock Cycles
+}
+
+Measurement latency_stats(uint64_t size_kb, PageSize page_size) {
+  NodeBuffer linked_list(size_kb * 1024 / 64, page_size);
+  return latency_on(linked_list);
+}
+
+uint64_t latency(uint64_t size_kb, PageSize page_size) {
+  return static_cast<uint64_t>(latency_stats(size_kb, page_size).median);
+};
+
+constexpr unsigned max_mlp_chains = 32;
+
+// Walk K independent chains in lockstep, K is a template parameter so the cursors stay in registers
+template <unsigned K>
+static uintptr_t chase_lockstep(Node *const *heads, uint64_t steps) {
+  Node *cur[K];
+  for (unsigned k = 0; k < K; k++) cur[k] = heads[k];
+  for (uint64_t s = 0; s < steps; s++) {
+    for (unsigned k = 0; k < K; k++) cur[k] = cur[k]->next;
+  }
+  uintptr_t res = 0;
+  for (unsigned k = 0; k < K; k++) res ^= reinterpret_cast<uintptr_t>(cur[k]);
+  return res;
+}
+
+template <size_t... Ks>
+static constexpr auto make_chase_table(std::index_sequence<Ks...>) {
+  return std::array<uintptr_t (*)(Node *const *, uint64_t), sizeof...(Ks)>{&chase_lockstep<Ks + 1>...};
+}
+
+static constexpr auto chase_table = make_chase_table(std::make_index_sequence<max_mlp_chains>{});
+
+std::vector<double> latency_mlp(uint64_t size_kb, unsigned max_chains) {
   // 1. Generate dataset
 
   uint64_t size = size_kb * 1024 / 64;
+  max_chains = static_cast<unsigned>(std::min<uint64_t>({max_chains, max_mlp_chains, size}));
+
   std::vector<size_t> order(size);
   for (size_t i = 0; i < size; i++) {
     order[i] = i;
   }
-  std::shuffle(order.begin(), order.end(), std::random_device());
-
-
-  // 2. Initialize data structure
+  WyRand rng = workload_rng("latency_mlp");
+  std::shuffle(order.begin(), order.end(), rng);
 
   std::vector<Node> linked_list(size);
-  for (size_t i = 0; i < size - 1; i++) {
+  for (size_t i = 0; i < size; i++) {
     linked_list[i].data = i;
   }
 
-  for (size_t i = 0; i < size - 1; i++) {
-    linked_list[order[i]].next = &linked_list[order[i + 1]];
+  // 2. Measure with K = 1 .. max_chains independent cycles over the same buffer
+
+  // Every K walks the same number of hops: at least one full lap, K sweeps multiply it otherwise
+  std::vector<double> ns_per_miss;
+  uint64_t total_hops = std::max<uint64_t>(size, 1 << 22);
+
+  for (unsigned K = 1; K <= max_chains; K++) {
+    // Cut the shuffled order into K segments and close each one into its own cycle
+    Node *heads[max_mlp_chains];
+    for (unsigned k = 0; k < K; k++) {
+      size_t begin = size * k / K;
+      size_t end = size * (k + 1) / K;
+      for (size_t i = begin; i < end - 1; i++) {
+        linked_list[order[i]].next = &linked_list[order[i + 1]];
+      }
+      linked_list[order[end - 1]].next = &linked_list[order[begin]];
+      heads[k] = &linked_list[order[begin]];
+    }
+
+    // Warm-up phase: traverse once to load into cache if it fits
+    doNotOptimizeAway(chase_table[K - 1](heads, size / K));
+
+    uint64_t steps = total_hops / K;
+    auto start = std::chrono::high_resolution_clock::now();
+    doNotOptimizeAway(chase_table[K - 1](heads, steps));
+    auto end = std::chrono::high_resolution_clock::now();
+
+    double ns = std::chrono::duration<double, std::nano>(end - start).count();
+    ns_per_miss.push_back(ns / static_cast<double>(steps * K));
+  }
+
+  return ns_per_miss;
+}
+
+std::vector<size_t> detect_knees(const std::vector<double>& ys, double rise, double min_step) {
+  std::vector<size_t> knees;
+  if (ys.empty()) return knees;
+
+  auto above = [&](double y, double plateau) { return y > plateau * (1 + rise) + min_step; };
+  double plateau = ys[0];
+  for (size_t i = 1; i < ys.size(); i++) {
+    if (!above(ys[i], plateau) || (i + 1 < ys.size() && !above(ys[i + 1], plateau))) {
+      plateau = std::min(plateau, ys[i]);
+      continue;
+    }
+    knees.push_back(i - 1);
+    while (i + 1 < ys.size() && ys[i + 1] > ys[i] * (1 + rise / 2)) i++;
+    plateau = ys[i];
   }
-  linked_list[order[size - 1]].next = &linked_list[order[0]];
+  return knees;
+}
+
+// Cost of one pointer-chase hop
+struct HopCost {
+  double cycles;
+  double ns;
+};
 
+// Chase a cycle of the given length starting at head: one warm-up lap, then at least
+// 2^22 timed hops. Return the cost per hop.
+static HopCost chase_cycle(Node *head, size_t length) {
+  // Warm-up phase: traverse once to load into cache and TLB if it fits
+  Node *current = head;
+  for (size_t i = 0; i < length; i++) {
+    current = current->next;
+  }
+  doNotOptimizeAway(current);
 
-  // 3. Measure data structure
+  uint64_t hops = std::max<uint64_t>(length, 1 << 22);
 
-  // Warm-up phase: traverse once to load into cache if it fits
-  Node *current = &linked_list[0];
-  for (size_t i = 0; i < size; i++) {
+  CycleTimer timer;
+  timer.start();
+  for (uint64_t i = 0; i < hops; i++) {
     current = current->next;
   }
   doNotOptimizeAway(current);
+  timer.stop();
+
+  return {timer.cycles() / static_cast<double>(hops), timer.ns() / static_cast<double>(hops)};
+}
+
+// Link the given nodes into one cycle in the given order and return its head
+static Node *link_cycle(const std::vector<Node *>& nodes) {
+  for (size_t i = 0; i < nodes.size() - 1; i++) {
+    nodes[i]->next = nodes[i + 1];
+  }
+  nodes.back()->next = nodes.front();
+  return nodes.front();
+}
+
+// Link the given nodes into one cycle in random order and return its head
+static Node *link_random_cycle(std::vector<Node *>& nodes, WyRand& rng) {
+  std::shuffle(nodes.begin(), nodes.end(), rng);
+  return link_cycle(nodes);
+}
+
+// Link the given nodes into one cycle in random order and return the cost per hop
+static HopCost chase_random_cycle(std::vector<Node *>& nodes, WyRand& rng) {
+  return chase_cycle(link_random_cycle(nodes, rng), nodes.size());
+}
 
-  // Actual measurement: traverse multiple times for accurate measurement
-  uint64_t num_iterations = std::max<uint64_t>(1000000 / size, 100);
+double tlb_latency(uint64_t num_pages) {
+  constexpr size_t nodes_per_page = 4096 / sizeof(Node);
+  num_pages = std::max<uint64_t>(num_pages, 2);
 
-  PerfEvent e;
-  e.startCounters();
+  WyRand rng = workload_rng("tlb_latency");
+
+  // 4K pages so every hop needs its own TLB entry; the random line within the page
+  // spreads the nodes over all cache sets
+  NodeBuffer pages(num_pages * nodes_per_page, Page4K);
+  std::vector<Node *> nodes(num_pages);
+  for (size_t p = 0; p < num_pages; p++) {
+    nodes[p] = &pages[p * nodes_per_page + rng() % nodes_per_page];
+    nodes[p]->data = p;
+  }
+  return chase_random_cycle(nodes, rng).cycles;
+}
+
+// Same number of lines as tlb_latency(num_pages), packed contiguously on as few pages as possible
+static double packed_latency(uint64_t num_lines) {
+  num_lines = std::max<uint64_t>(num_lines, 2);
+
+  WyRand rng = workload_rng("packed_latency");
+
+  NodeBuffer lines(num_lines, PageTHP);
+  std::vector<Node *> nodes(num_lines);
+  for (size_t i = 0; i < num_lines; i++) {
+    nodes[i] = &lines[i];
+    nodes[i]->data = i;
+  }
+  return chase_random_cycle(nodes, rng).cycles;
+}
 
-  current = &linked_list[0];
-  for (size_t iter = 0; iter < num_iterations; iter++) {
-    for (size_t i = 0; i < size; i++) {
-      current = current->next;
+TlbProfile tlb_profile(uint64_t max_pages) {
+  TlbProfile profile{};
+  std::vector<double> translation;
+  for (unsigned step = 8;; step++) {
+    uint64_t pages = static_cast<uint64_t>(std::llround(std::exp2(step / 4.0)));
+    if (pages > max_pages) break;
+    profile.pages.push_back(pages);
+    profile.latency.push_back(tlb_latency(pages));
+    profile.cache_latency.push_back(packed_latency(pages));
+    translation.push_back(std::max(profile.latency.back() - profile.cache_latency.back(), 0.0));
+  }
+
+  // One entry per page, so the last working set on a plateau is the number of entries
+  auto knees = detect_knees(translation, 0.5, 2.0);
+  if (knees.size() > 0) profile.l1_dtlb_entries = profile.pages[knees[0]];
+  if (knees.size() > 1) profile.stlb_entries = profile.pages[knees[1]];
+  return profile;
+}
+
+uint64_t parse_cache_size_kb(const std::string& size) {
+  size_t digits = 0;
+  while (digits < size.size() && std::isdigit(static_cast<unsigned char>(size[digits]))) digits++;
+  if (digits == 0) return 0;
+
+  uint64_t value = std::stoull(size.substr(0, digits));
+  switch (digits < size.size() ? size[digits] : '\0') {
+    case 'K': return value;
+    case 'M': return value * 1024;
+    case 'G': return value * 1024 * 1024;
+    default: return value / 1024; // plain bytes
+  }
+}
+
+// Data and unified caches of cpu0 from sysfs, ordered by level
+static std::vector<CacheLevel> read_sysfs_caches() {
+  std::vector<CacheLevel> levels;
+  for (unsigned index = 0;; index++) {
+    std::string dir = "/sys/devices/system/cpu/cpu0/cache/index" + std::to_string(index) + "/";
+    std::ifstream level_file(dir + "level"), type_file(dir + "type"), size_file(dir + "size");
+    if (!level_file || !type_file || !size_file) break;
+
+    CacheLevel cache{};
+    std::string size;
+    level_file >> cache.level;
+    type_file >> cache.type;
+    size_file >> size;
+    if (cache.type == "Instruction" || size.empty()) continue;
+
+    cache.size_kb = parse_cache_size_kb(size);
+    levels.push_back(cache);
+  }
+  std::sort(levels.begin(), levels.end(), [](auto& a, auto& b) { return a.level < b.level; });
+  return levels;
+}
+
+std::vector<CacheLevel> cache_hierarchy() {
+  std::vector<CacheLevel> levels = read_sysfs_caches();
+  uint64_t llc_kb = levels.empty() ? 64 * 1024 : levels.back().size_kb;
+
+  // 1. Logarithmic latency sweep over a randomly linked list
+
+  WyRand rng = workload_rng("cache_hierarchy");
+
+  std::vector<uint64_t> sizes_kb;
+  std::vector<HopCost> costs;
+  for (unsigned step = 8;; step++) {
+    uint64_t size_kb = static_cast<uint64_t>(std::llround(std::exp2(step / 4.0)));
+    if (size_kb > 4 * llc_kb) break;
+
+    NodeBuffer buffer(size_kb * 1024 / sizeof(Node), PageDefault);
+    std::vector<Node *> nodes(buffer.size());
+    for (size_t i = 0; i < buffer.size(); i++) {
+      nodes[i] = &buffer[i];
+      nodes[i]->data = i;
     }
+    sizes_kb.push_back(size_kb);
+    costs.push_back(chase_random_cycle(nodes, rng));
   }
-  doNotOptimizeAway(current);
 
-  e.stopCounters();
+  std::vector<double> cycles(costs.size());
+  std::transform(costs.begin(), costs.end(), cycles.begin(), [](auto& c) { return c.cycles; });
+  std::vector<size_t> knees = detect_knees(cycles, 0.25, 1.0);
 
-  uint64_t total_lookups = num_iterations * size;
-  uint64_t cycles = static_cast<uint64_t>(e.getCounter("cycles"));
-  uint64_t cycles_per_lookup = cycles / total_lookups;
+  // 2. Match knees to the sysfs levels (closest within a factor of 4), or take them as levels
 
-  return cycles_per_lookup; // Latency in Processor Clock Cycles
-};
+  if (levels.empty()) {
+    for (size_t k = 0; k < knees.size(); k++) {
+      levels.push_back({static_cast<unsigned>(k + 1), "Unified", 0, sizes_kb[knees[k]], 0, 0, 0});
+    }
+  } else {
+    for (auto& cache : levels) {
+      double best = std::log2(4.0);
+      for (size_t k : knees) {
+        double distance = std::abs(std::log2(static_cast<double>(sizes_kb[k]) / cache.size_kb));
+        if (distance <= best) {
+          best = distance;
+          cache.detected_kb = sizes_kb[k];
+        }
+      }
+    }
+  }
+  levels.push_back({static_cast<unsigned>(levels.size() + 1), "Memory", 0, 0, 0, 0, 0});
+
+  // 3. Latency: median over the plateau of every level, bandwidth: in the middle of it
+
+  uint64_t lower_kb = 0;
+  for (auto& level : levels) {
+    uint64_t upper_kb = level.detected_kb ? level.detected_kb : level.size_kb;
+    if (level.type == "Memory") upper_kb = sizes_kb.empty() ? 0 : sizes_kb.back();
+
+    std::vector<HopCost> plateau;
+    for (size_t i = 0; i < sizes_kb.size(); i++) {
+      if (sizes_kb[i] > lower_kb && sizes_kb[i] <= upper_kb) plateau.push_back(costs[i]);
+    }
+    if (!plateau.empty()) {
+      auto by_cycles = [](auto& a, auto& b) { return a.cycles < b.cycles; };
+      std::nth_element(plateau.begin(), plateau.begin() + plateau.size() / 2, plateau.end(), by_cycles);
+      level.latency_cycles = plateau[plateau.size() / 2].cycles;
+      level.latency_ns = plateau[plateau.size() / 2].ns;
+    }
+
+    uint64_t middle_kb = level.type == "Memory" ? upper_kb
+                                                : static_cast<uint64_t>(std::sqrt(std::max<double>(lower_kb, 4) * upper_kb));
+    if (middle_kb) level.bandwidth = bandwidth_simd(middle_kb, best_read_kernel());
+    lower_kb = std::max(lower_kb, upper_kb);
+  }
+
+  return levels;
+}
 
-uint64_t bandwidth(uint64_t size_kb) {
+void print_cache_hierarchy(std::ostream& out, const std::vector<CacheLevel>& levels) {
+  out << std::setw(8) << "level" << std::setw(10) << "type" << std::setw(12) << "size_kb"
+      << std::setw(12) << "detected_kb" << std::setw(10) << "cycles" << std::setw(10) << "ns"
+      << std::setw(12) << "MB/s" << std::endl;
+  for (auto& level : levels) {
+    out << std::setw(8) << level.level << std::setw(10) << level.type << std::setw(12) << level.size_kb
+        << std::setw(12) << level.detected_kb << std::fixed << std::setprecision(1)
+        << std::setw(10) << level.latency_cycles << std::setw(10) << level.latency_ns
+        << std::defaultfloat << std::setw(12) << level.bandwidth << std::endl;
+  }
+}
+
+std::vector<size_t> strided_permutation(size_t size, uint64_t stride, bool backward, bool page_offset,
+                                        WyRand& rng) {
+  constexpr size_t nodes_per_page = 4096 / sizeof(Node);
+  stride = std::max<uint64_t>(stride, 1);
+
+  std::vector<size_t> offsets((size + nodes_per_page - 1) / nodes_per_page, 0);
+  if (page_offset) {
+    for (auto& offset : offsets) offset = rng() % nodes_per_page;
+  }
+
+  std::vector<size_t> order;
+  order.reserve(size);
+  for (size_t start = 0; start < std::min<size_t>(stride, size); start++) {
+    for (size_t i = start; i < size; i += stride) {
+      size_t page = i / nodes_per_page;
+      // The last page may be partial: rotate within the lines it actually has
+      size_t lines = std::min(nodes_per_page, size - page * nodes_per_page);
+      order.push_back(page * nodes_per_page + (i % nodes_per_page + offsets[page]) % lines);
+    }
+  }
+  if (backward) std::reverse(order.begin(), order.end());
+  return order;
+}
+
+std::vector<PrefetchResult> prefetch_sweep(uint64_t size_kb) {
+  uint64_t size = std::max<uint64_t>(size_kb * 1024 / 64, 2);
+  WyRand rng = workload_rng("prefetch_sweep");
+
+  NodeBuffer array(size, PageDefault);
+  for (size_t i = 0; i < size; i++) {
+    array[i].data = i;
+  }
+
+  // Baseline: the same lines in random order, which no prefetcher can follow
+  std::vector<Node *> nodes(size);
+  for (size_t i = 0; i < size; i++) {
+    nodes[i] = &array[i];
+  }
+  double random_ns = chase_random_cycle(nodes, rng).ns;
+
+  // Dependent loads along the pattern: only a prefetcher can hide their latency
+  std::vector<PrefetchResult> results;
+  for (uint64_t stride = 1; stride <= 64; stride *= 2) {
+    for (bool backward : {false, true}) {
+      for (bool page_offset : {false, true}) {
+        std::vector<Node *> order;
+        for (size_t index : strided_permutation(size, stride, backward, page_offset, rng)) {
+          order.push_back(&array[index]);
+        }
+        double strided_ns = chase_cycle(link_cycle(order), order.size()).ns;
+        results.push_back({stride, backward, page_offset, strided_ns, random_ns, 1.0 - strided_ns / random_ns});
+      }
+    }
+  }
+  return results;
+}
+
+void print_prefetch_sweep(std::ostream& out, const std::vector<PrefetchResult>& results) {
+  out << std::setw(8) << "stride" << std::setw(10) << "direction" << std::setw(8) << "offset"
+      << std::setw(12) << "strided_ns" << std::setw(12) << "random_ns" << std::setw(8) << "saving" << std::endl;
+  for (auto& r : results) {
+    out << std::setw(8) << r.stride << std::setw(10) << (r.backward ? "backward" : "forward")
+        << std::setw(8) << (r.page_offset ? "yes" : "no") << std::fixed << std::setprecision(2)
+        << std::setw(12) << r.strided_ns << std::setw(12) << r.random_ns
+        << std::setprecision(0) << std::setw(7) << r.saving * 100 << "%" << std::defaultfloat << std::endl;
+  }
+}
+
+// Read the data field of every node in [nodes, nodes + count), iterations times
+static void read_nodes(const Node *nodes, size_t count, uint64_t iterations) {
+  volatile uint64_t res{0};
+  for (size_t iter = 0; iter < iterations; iter++) {
+    for (size_t i = 0; i < count; i++) {
+      res = nodes[i].data;
+    }
+  }
+  doNotOptimizeAway(res);
+}
+
+// Pin the calling thread to a single CPU
+static void pin_to_core(unsigned cpu) {
+  cpu_set_t set;
+  CPU_ZERO(&set);
+  CPU_SET(cpu, &set);
+  if (pthread_setaffinity_np(pthread_self(), sizeof(set), &set) != 0) {
+    std::cerr << "Could not pin thread to cpu " << cpu << std::endl;
+  }
+}
+
+// Read bandwidth over the given buffer, in MB/s
+static Measurement bandwidth_on(NodeBuffer& array) {
 
   // 1. Initialize data structure
 
-  uint64_t size = size_kb * 1024 / 64;
-  std::vector<Node> array(size);
+  uint64_t size = array.size();
   for (size_t i = 0; i < size; i++) {
     array[i].data = i;
   }
@@ -78,40 +783,734 @@ uint64_t bandwidth(uint64_t size_kb) {
   // 2. Measure data structure
 
   // Warm-up phase
-  volatile uint64_t res{0};
+  read_nodes(array.data(), size, 1);
+
+  // Actual measurement: read sequentially as often as the time budget allows
+  auto pass = [&](uint64_t num_iterations) {
+    auto start = std::chrono::high_resolution_clock::now();
+
+    read_nodes(array.data(), size, num_iterations);
+
+    auto end = std::chrono::high_resolution_clock::now();
+
+    // Calculate bandwidth
+    uint64_t total_bytes = num_iterations * size * sizeof(Node);
+    auto duration = std::chrono::duration_cast<std::chrono::nanoseconds>(end - start).count();
+    double seconds_elapsed = duration / 1e9;
+
+    // Convert to MB/s
+    return (total_bytes / seconds_elapsed) / (1024.0 * 1024.0);
+  };
+
+  return summarize(run_adaptive(pass));
+}
+
+Measurement bandwidth_stats(uint64_t size_kb, PageSize page_size) {
+  NodeBuffer array(size_kb * 1024 / 64, page_size);
+  return bandwidth_on(array);
+}
+
+uint64_t bandwidth(uint64_t size_kb, PageSize page_size) {
+  return static_cast<uint64_t>(bandwidth_stats(size_kb, page_size).median);
+};
+
+std::vector<PageSizeResult> page_size_sweep(uint64_t size_kb) {
+  std::vector<PageSizeResult> results;
+  for (PageSize page_size : {Page4K, PageTHP, Page2M, Page1G}) {
+    // Probe which pages the system actually hands out for this size, then measure with those
+    PageSize backing = NodeBuffer(size_kb * 1024 / 64, page_size).backing();
+    results.push_back({page_size, backing, latency(size_kb, backing), bandwidth(size_kb, backing)});
+  }
+  return results;
+}
+
+NumaMatrix numa_matrix(uint64_t size_kb) {
+  uint64_t size = size_kb * 1024 / 64;
+
+  // Single node (or no NUMA support at all): one entry, measured without any binding
+  if (numa_available() < 0 || numa_max_node() == 0) {
+    NodeBuffer linked_list(size, PageDefault), array(size, PageDefault);
+    return {1, {static_cast<uint64_t>(latency_on(linked_list).median)},
+            {static_cast<uint64_t>(bandwidth_on(array).median)}};
+  }
+
+  unsigned nodes = static_cast<unsigned>(numa_max_node() + 1);
+  NumaMatrix matrix{nodes, std::vector<uint64_t>(nodes * nodes), std::vector<uint64_t>(nodes * nodes)};
+
+  auto usable = [](unsigned node, bool needs_cpus) {
+    if (!numa_bitmask_isbitset(numa_all_nodes_ptr, node)) return false;
+    if (!needs_cpus) return numa_node_size64(static_cast<int>(node), nullptr) > 0;
+    bitmask *cpus = numa_allocate_cpumask();
+    bool has_cpus = numa_node_to_cpus(static_cast<int>(node), cpus) == 0 && numa_bitmask_weight(cpus) > 0;
+    numa_free_cpumask(cpus);
+    return has_cpus;
+  };
+
+  for (unsigned cpu_node = 0; cpu_node < nodes; cpu_node++) {
+    if (!usable(cpu_node, true)) continue;
+    for (unsigned mem_node = 0; mem_node < nodes; mem_node++) {
+      if (!usable(mem_node, false)) continue;
+
+      // Measure on a separate thread so the caller's affinity stays untouched
+      std::thread worker([&] {
+        numa_run_on_node(static_cast<int>(cpu_node));
+        NodeBuffer linked_list(size, PageDefault, static_cast<int>(mem_node));
+        NodeBuffer array(size, PageDefault, static_cast<int>(mem_node));
+        matrix.latency[cpu_node * nodes + mem_node] = static_cast<uint64_t>(latency_on(linked_list).median);
+        matrix.bandwidth[cpu_node * nodes + mem_node] = static_cast<uint64_t>(bandwidth_on(array).median);
+      });
+      worker.join();
+    }
+  }
+  return matrix;
+}
+
+void print_numa_matrix(std::ostream& out, const NumaMatrix& matrix) {
+  auto print = [&](const char *title, const std::vector<uint64_t>& values) {
+    out << title << std::endl << std::setw(10) << "cpu\\mem";
+    for (unsigned mem = 0; mem < matrix.nodes; mem++) out << std::setw(10) << mem;
+    out << std::endl;
+    for (unsigned cpu = 0; cpu < matrix.nodes; cpu++) {
+      out << std::setw(10) << cpu;
+      for (unsigned mem = 0; mem < matrix.nodes; mem++) out << std::setw(10) << values[cpu * matrix.nodes + mem];
+      out << std::endl;
+    }
+  };
+  print("LATENCY (cycles/lookup):", matrix.latency);
+  print("BANDWIDTH (MB/s):", matrix.bandwidth);
+}
+
+std::vector<LoadedLatencyPoint> loaded_latency(uint64_t size_kb, unsigned load_threads,
+                                               const std::vector<uint64_t>& delays) {
+  using clock = std::chrono::steady_clock;
+
+  std::vector<unsigned> cores = available_cores();
+  if (cores.size() <= load_threads) {
+    std::cerr << "Only " << cores.size() << " cores for " << load_threads
+              << " load threads and the chaser, threads will share cores" << std::endl;
+  }
+
+  // 1. Initialize data structures: one random cycle for the chaser, one array sliced among the loaders
+
+  uint64_t size = std::max<uint64_t>(size_kb * 1024 / 64, 2);
+  WyRand rng = workload_rng("loaded_latency");
+
+  NodeBuffer linked_list(size, PageDefault);
+  std::vector<Node *> nodes(size);
   for (size_t i = 0; i < size; i++) {
-    res = array[i].data;
+    nodes[i] = &linked_list[i];
+    nodes[i]->data = i;
+  }
+  Node *head = link_random_cycle(nodes, rng);
+  nodes = {}; // only the links are needed from here on
+
+  NodeBuffer array(size, PageDefault);
+  uint64_t slice = size / std::max(load_threads, 1u);
+
+  // 2. Measure: idle latency first, then with the loaders throttled by every delay
+
+  std::vector<LoadedLatencyPoint> points;
+
+  auto measure = [&](unsigned loaders, uint64_t delay) {
+    std::atomic<bool> stop{false};
+    std::barrier sync(loaders + 1);
+    std::vector<uint64_t> bytes(loaders);
+    std::vector<clock::duration> durations(loaders);
+
+    auto loader = [&](unsigned t) {
+      pin_to_core(cores[(t + 1) % cores.size()]);
+      Node *begin = &array[t * slice];
+      Node *end = begin + slice;
+      uint64_t sum = 0, lines = 0;
+
+      sync.arrive_and_wait();
+      auto start = clock::now();
+      while (!stop.load(std::memory_order_relaxed)) {
+        for (Node *line = begin; line < end && !stop.load(std::memory_order_relaxed); line += 8) {
+          for (Node *n = line; n < std::min(line + 8, end); n++) sum += n->key + n->data;
+          lines += std::min<uint64_t>(8, end - line);
+          for (uint64_t d = 0; d < delay; d++) _mm_pause();
+        }
+      }
+      durations[t] = clock::now() - start;
+      bytes[t] = lines * sizeof(Node);
+      doNotOptimizeAway(sum);
+    };
+
+    LoadedLatencyPoint point{delay, 0, 0, 0};
+    std::thread chaser([&] {
+      pin_to_core(cores[0]);
+      sync.arrive_and_wait();
+      HopCost cost = chase_cycle(head, size);
+      stop.store(true);
+      point.latency_cycles = cost.cycles;
+      point.latency_ns = cost.ns;
+    });
+
+    std::vector<std::thread> threads;
+    for (unsigned t = 0; t < loaders; t++) {
+      threads.emplace_back(loader, t);
+    }
+    chaser.join();
+    for (auto& thread : threads) {
+      thread.join();
+    }
+
+    for (unsigned t = 0; t < loaders; t++) {
+      double seconds_elapsed = std::chrono::duration<double>(durations[t]).count();
+      point.bandwidth += static_cast<uint64_t>((bytes[t] / seconds_elapsed) / (1024.0 * 1024.0));
+    }
+    points.push_back(point);
+  };
+
+  measure(0, 0);
+  if (load_threads > 0 && slice > 0) {
+    std::vector<uint64_t> sorted = delays;
+    std::sort(sorted.rbegin(), sorted.rend());
+    for (uint64_t delay : sorted) {
+      measure(load_threads, delay);
+    }
+  }
+
+  return points;
+}
+
+void print_loaded_latency(std::ostream& out, const std::vector<LoadedLatencyPoint>& points) {
+  out << std::setw(10) << "delay" << std::setw(12) << "MB/s" << std::setw(10) << "ns"
+      << std::setw(10) << "cycles" << std::endl;
+  for (auto& point : points) {
+    out << std::setw(10) << point.delay << std::setw(12) << point.bandwidth << std::fixed << std::setprecision(1)
+        << std::setw(10) << point.latency_ns << std::setw(10) << point.latency_cycles << std::defaultfloat << std::endl;
+  }
+}
+
+std::vector<uint64_t> bandwidth_mt(uint64_t size_kb, unsigned num_threads) {
+  using clock = std::chrono::steady_clock;
+
+  std::vector<unsigned> cores = available_cores();
+  if (num_threads == 0) num_threads = static_cast<unsigned>(cores.size());
+
+  // 1. Initialize data structure, one contiguous slice per thread
+
+  uint64_t size = size_kb * 1024 / 64;
+  num_threads = static_cast<unsigned>(std::clamp<uint64_t>(num_threads, 1, std::max<uint64_t>(size, 1)));
+  // Anonymous mapping, left untouched so each worker's first touch places its own slice
+  NodeBuffer array(size, PageDefault);
+
+  uint64_t slice = size / num_threads;
+  auto begin_of = [&](unsigned t) { return t * slice; };
+  auto end_of = [&](unsigned t) { return (t == num_threads - 1) ? size : (t + 1) * slice; };
+
+  // Run body(t) on one thread per slice, each pinned to its own core
+  auto on_workers = [&](auto&& body) {
+    std::vector<std::thread> threads;
+    for (unsigned t = 0; t < num_threads; t++) {
+      threads.emplace_back([&, t] {
+        pin_to_core(cores[t % cores.size()]);
+        body(t);
+      });
+    }
+    for (auto& thread : threads) {
+      thread.join();
+    }
+  };
+
+  // First touch from the pinned thread so pages land on its local node
+  on_workers([&](unsigned t) {
+    for (size_t i = begin_of(t); i < end_of(t); i++) {
+      array[i].data = i;
+    }
+    read_nodes(&array[begin_of(t)], end_of(t) - begin_of(t), 1);
+  });
+
+  // 2. Measure data structure: every pass starts all workers behind a barrier
+
+  auto to_mbps = [](uint64_t bytes, clock::duration duration) {
+    double seconds_elapsed = std::chrono::duration<double>(duration).count();
+    return (bytes / seconds_elapsed) / (1024.0 * 1024.0);
+  };
+
+  std::vector<std::vector<double>> per_thread(num_threads);
+  auto pass = [&](uint64_t iterations) {
+    std::vector<clock::time_point> starts(num_threads), ends(num_threads);
+    std::barrier sync(num_threads);
+    on_workers([&](unsigned t) {
+      sync.arrive_and_wait();
+      starts[t] = clock::now();
+      read_nodes(&array[begin_of(t)], end_of(t) - begin_of(t), iterations);
+      ends[t] = clock::now();
+    });
+
+    for (unsigned t = 0; t < num_threads; t++) {
+      per_thread[t].push_back(to_mbps(iterations * (end_of(t) - begin_of(t)) * sizeof(Node), ends[t] - starts[t]));
+    }
+    auto first_start = *std::min_element(starts.begin(), starts.end());
+    auto last_end = *std::max_element(ends.begin(), ends.end());
+    return to_mbps(iterations * size * sizeof(Node), last_end - first_start);
+  };
+
+  // The last samples.size() passes are the measured ones, the ones before calibrated the iterations
+  std::vector<double> samples = run_adaptive(pass);
+  std::vector<uint64_t> result(num_threads + 1);
+  result[0] = static_cast<uint64_t>(summarize(samples).median);
+  for (unsigned t = 0; t < num_threads; t++) {
+    std::vector<double> measured(per_thread[t].end() - samples.size(), per_thread[t].end());
+    result[t + 1] = static_cast<uint64_t>(summarize(measured).median);
+  }
+
+  return result;
+}
+
+CoreToCoreMatrix core_to_core_matrix() {
+  std::vector<unsigned> cores = available_cores();
+  size_t n = cores.size();
+  CoreToCoreMatrix matrix{cores, std::vector<double>(n * n), std::vector<double>(n * n)};
+  if (n < 2) {
+    std::cerr << "Only one core available, nothing to ping-pong between" << std::endl;
+    return matrix;
+  }
+
+  // Split the time budget over all ordered pairs
+  double budget = std::max(seconds / static_cast<double>(n * (n - 1)), 0.01);
+
+  for (size_t i = 0; i < n; i++) {
+    for (size_t j = 0; j < n; j++) {
+      if (i == j) continue;
+
+      Node line{};
+      std::atomic_ref<uint64_t> sequence(line.data);
+      std::atomic<bool> stop{false};
+
+      // Pong: answer every odd sequence number with the next even one
+      std::thread pong([&] {
+        pin_to_core(cores[j]);
+        while (!stop.load(std::memory_order_relaxed)) {
+          uint64_t value = sequence.load(std::memory_order_acquire);
+          if (value & 1) {
+            sequence.store(value + 1, std::memory_order_release);
+          } else {
+            _mm_pause();
+          }
+        }
+      });
+
+      // Ping on its own thread so the caller's affinity stays untouched
+      std::thread ping([&] {
+        pin_to_core(cores[i]);
+        uint64_t value = 0;
+        std::vector<double> cycles;
+
+        auto pass = [&](uint64_t round_trips) {
+          CycleTimer timer;
+          timer.start();
+          for (uint64_t r = 0; r < round_trips; r++) {
+            sequence.store(value + 1, std::memory_order_release);
+            value += 2;
+            while (sequence.load(std::memory_order_acquire) != value) {
+            }
+          }
+          timer.stop();
+          cycles.push_back(timer.cycles() / static_cast<double>(2 * round_trips));
+          return timer.ns() / static_cast<double>(2 * round_trips);
+        };
+        std::vector<double> ns = run_adaptive(pass, budget);
+
+        // run_adaptive() returns the trailing passes, cycles recorded the calibration passes as well
+        cycles.erase(cycles.begin(), cycles.end() - static_cast<std::ptrdiff_t>(ns.size()));
+        matrix.latency_ns[i * n + j] = summarize(ns).median;
+        matrix.latency_cycles[i * n + j] = summarize(cycles).median;
+      });
+
+      ping.join();
+      stop.store(true);
+      pong.join();
+    }
   }
+  return matrix;
+}
+
+void print_core_to_core_matrix(std::ostream& out, const CoreToCoreMatrix& matrix) {
+  size_t n = matrix.cores.size();
+  std::ios_base::fmtflags flags = out.flags();
+  std::streamsize precision = out.precision();
+  auto print = [&](const char *title, const std::vector<double>& values) {
+    out << title << std::endl << std::setw(10) << "ping\\pong";
+    for (unsigned cpu : matrix.cores) out << std::setw(10) << cpu;
+    out << std::endl;
+    for (size_t i = 0; i < n; i++) {
+      out << std::setw(10) << matrix.cores[i];
+      for (size_t j = 0; j < n; j++) out << std::setw(10) << std::fixed << std::setprecision(1) << values[i * n + j];
+      out << std::endl;
+    }
+  };
+  print("ONE-WAY LATENCY (ns):", matrix.latency_ns);
+  print("ONE-WAY LATENCY (cycles):", matrix.latency_cycles);
+  out.flags(flags);
+  out.precision(precision);
+}
+
+uint64_t stream_bandwidth(uint64_t size_kb, StreamKernel kernel) {
+
+  // 1. Initialize data structure
 
-  // Actual measurement: read sequentially multiple times
-  uint64_t num_iterations = std::max<uint64_t>(1000000 / size, 100);
+  uint64_t num_arrays = (kernel == Copy || kernel == Scale) ? 2 : 3;
+  uint64_t size = std::max<uint64_t>(size_kb * 1024 / sizeof(double) / num_arrays, 1);
+  std::vector<double> a(size, 1.0), b(size, 2.0), c(size, 0.0);
+  const double q = 3.0;
 
-  auto start = std::chrono::high_resolution_clock::now();
+  double *pa = a.data(), *pb = b.data(), *pc = c.data();
+  auto run = [&](uint64_t iterations) {
+    for (uint64_t iter = 0; iter < iterations; iter++) {
+      switch (kernel) {
+        case Copy:
+          for (size_t i = 0; i < size; i++) pc[i] = pa[i];
+          break;
+        case Scale:
+          for (size_t i = 0; i < size; i++) pb[i] = q * pc[i];
+          break;
+        case Add:
+          for (size_t i = 0; i < size; i++) pc[i] = pa[i] + pb[i];
+          break;
+        case Triad:
+          for (size_t i = 0; i < size; i++) pa[i] = pb[i] + q * pc[i];
+          break;
+      }
+      doNotOptimizeAway(pa);
+      doNotOptimizeAway(pb);
+      doNotOptimizeAway(pc);
+    }
+  };
+
+  // 2. Measure data structure
+
+  // Warm-up phase
+  run(1);
+
+  auto pass = [&](uint64_t num_iterations) {
+    auto start = std::chrono::high_resolution_clock::now();
+    run(num_iterations);
+    auto end = std::chrono::high_resolution_clock::now();
+
+    // Calculate bandwidth: every array is read once per element, the destination is
+    // additionally fetched by the write-allocate before being written back
+    uint64_t bytes_per_element = (num_arrays + 1) * sizeof(double);
+    uint64_t total_bytes = num_iterations * size * bytes_per_element;
+    auto duration = std::chrono::duration_cast<std::chrono::nanoseconds>(end - start).count();
+    double seconds_elapsed = duration / 1e9;
+
+    return (total_bytes / seconds_elapsed) / (1024.0 * 1024.0);
+  };
+
+  return static_cast<uint64_t>(summarize(run_adaptive(pass)).median);
+}
 
-  for (size_t iter = 0; iter < num_iterations; iter++) {
-    for (size_t i = 0; i < size; i++) {
-      res = array[i].data;
+// Full-line read kernels: every byte of every node is loaded, adds into independent
+// accumulators keep the loads from serializing on a single register. The scalar kernel is kept
+// out of the auto-vectorizer, which would otherwise turn it into SSE2 loads at -O3
+__attribute__((optimize("no-tree-vectorize")))
+static uint64_t read_lines_scalar(const Node *nodes, size_t count, uint64_t iterations) {
+  uint64_t acc0 = 0, acc1 = 0, acc2 = 0, acc3 = 0;
+  for (uint64_t iter = 0; iter < iterations; iter++) {
+    for (size_t i = 0; i < count; i++) {
+      const uint64_t *p = reinterpret_cast<const uint64_t *>(&nodes[i]);
+      acc0 += p[0] + p[4];
+      acc1 += p[1] + p[5];
+      acc2 += p[2] + p[6];
+      acc3 += p[3] + p[7];
     }
+    asm volatile("" : : : "memory");
   }
+  return acc0 + acc1 + acc2 + acc3;
+}
+
+__attribute__((target("avx2")))
+static uint64_t read_lines_avx2(const Node *nodes, size_t count, uint64_t iterations) {
+  __m256i acc0 = _mm256_setzero_si256(), acc1 = _mm256_setzero_si256();
+  __m256i acc2 = _mm256_setzero_si256(), acc3 = _mm256_setzero_si256();
+  for (uint64_t iter = 0; iter < iterations; iter++) {
+    size_t i = 0;
+    for (; i + 2 <= count; i += 2) {
+      const __m256i *p = reinterpret_cast<const __m256i *>(&nodes[i]);
+      acc0 = _mm256_add_epi64(acc0, _mm256_load_si256(p));
+      acc1 = _mm256_add_epi64(acc1, _mm256_load_si256(p + 1));
+      acc2 = _mm256_add_epi64(acc2, _mm256_load_si256(p + 2));
+      acc3 = _mm256_add_epi64(acc3, _mm256_load_si256(p + 3));
+    }
+    for (; i < count; i++) {
+      const __m256i *p = reinterpret_cast<const __m256i *>(&nodes[i]);
+      acc0 = _mm256_add_epi64(acc0, _mm256_load_si256(p));
+      acc1 = _mm256_add_epi64(acc1, _mm256_load_si256(p + 1));
+    }
+    asm volatile("" : : : "memory");
+  }
+  __m256i acc = _mm256_add_epi64(_mm256_add_epi64(acc0, acc1), _mm256_add_epi64(acc2, acc3));
+  alignas(32) uint64_t lanes[4];
+  _mm256_store_si256(reinterpret_cast<__m256i *>(lanes), acc);
+  return lanes[0] + lanes[1] + lanes[2] + lanes[3];
+}
+
+__attribute__((target("avx512f")))
+static uint64_t read_lines_avx512(const Node *nodes, size_t count, uint64_t iterations) {
+  __m512i acc0 = _mm512_setzero_si512(), acc1 = _mm512_setzero_si512();
+  __m512i acc2 = _mm512_setzero_si512(), acc3 = _mm512_setzero_si512();
+  for (uint64_t iter = 0; iter < iterations; iter++) {
+    size_t i = 0;
+    for (; i + 4 <= count; i += 4) {
+      acc0 = _mm512_add_epi64(acc0, _mm512_load_si512(&nodes[i]));
+      acc1 = _mm512_add_epi64(acc1, _mm512_load_si512(&nodes[i + 1]));
+      acc2 = _mm512_add_epi64(acc2, _mm512_load_si512(&nodes[i + 2]));
+      acc3 = _mm512_add_epi64(acc3, _mm512_load_si512(&nodes[i + 3]));
+    }
+    for (; i < count; i++) {
+      acc0 = _mm512_add_epi64(acc0, _mm512_load_si512(&nodes[i]));
+    }
+    asm volatile("" : : : "memory");
+  }
+  __m512i acc = _mm512_add_epi64(_mm512_add_epi64(acc0, acc1), _mm512_add_epi64(acc2, acc3));
+  alignas(64) uint64_t lanes[8];
+  _mm512_store_si512(lanes, acc);
+  return lanes[0] + lanes[1] + lanes[2] + lanes[3] + lanes[4] + lanes[5] + lanes[6] + lanes[7];
+}
+
+bool read_kernel_supported(ReadKernel kernel) {
+  __builtin_cpu_init();
+  switch (kernel) {
+    case ScalarRead: return true;
+    case AVX2Read: return __builtin_cpu_supports("avx2");
+    case AVX512Read: return __builtin_cpu_supports("avx512f");
+  }
+  return false;
+}
+
+ReadKernel best_read_kernel() {
+  if (read_kernel_supported(AVX512Read)) return AVX512Read;
+  if (read_kernel_supported(AVX2Read)) return AVX2Read;
+  return ScalarRead;
+}
+
+uint64_t bandwidth_simd(uint64_t size_kb, ReadKernel kernel) {
+  if (!read_kernel_supported(kernel)) return 0;
+
+  auto read_lines = read_lines_scalar;
+  if (kernel == AVX2Read) read_lines = read_lines_avx2;
+  if (kernel == AVX512Read) read_lines = read_lines_avx512;
+
+  // 1. Initialize data structure
+
+  uint64_t size = std::max<uint64_t>(size_kb * 1024 / 64, 1);
+  std::vector<Node> array(size);
+  for (size_t i = 0; i < size; i++) {
+    array[i].key = i;
+    array[i].data = i;
+  }
+
+  // 2. Measure data structure
+
+  // Warm-up phase
+  uint64_t res = read_lines(array.data(), size, 1);
   doNotOptimizeAway(res);
 
-  auto end = std::chrono::high_resolution_clock::now();
+  // Actual measurement: read sequentially as often as the time budget allows
+  auto pass = [&](uint64_t num_iterations) {
+    auto start = std::chrono::high_resolution_clock::now();
+    res = read_lines(array.data(), size, num_iterations);
+    doNotOptimizeAway(res);
+    auto end = std::chrono::high_resolution_clock::now();
+
+    // Calculate bandwidth, now every byte credited is actually loaded
+    uint64_t total_bytes = num_iterations * size * sizeof(Node);
+    auto duration = std::chrono::duration_cast<std::chrono::nanoseconds>(end - start).count();
+    double seconds_elapsed = duration / 1e9;
 
-  // Calculate bandwidth
-  uint64_t total_bytes = num_iterations * size * sizeof(Node);
-  auto duration = std::chrono::duration_cast<std::chrono::nanoseconds>(end - start).count();
-  double seconds_elapsed = duration / 1e9;
+    return (total_bytes / seconds_elapsed) / (1024.0 * 1024.0);
+  };
 
-  // Convert to MB/s
-  uint64_t mbps = static_cast<uint64_t>((total_bytes / seconds_elapsed) / (1024.0 * 1024.0));
+  return static_cast<uint64_t>(summarize(run_adaptive(pass)).median);
+}
 
-  return mbps;
-};
+std::vector<uint64_t> bandwidth_per_isa(uint64_t size_kb) {
+  return {bandwidth_simd(size_kb, ScalarRead),
+          bandwidth_simd(size_kb, AVX2Read),
+          bandwidth_simd(size_kb, AVX512Read)};
+}
 
-std::vector<uint64_t> benchmark_datastructure(uint64_t size_kb, AccessPattern access_pattern) {
+// Overwrite [nodes, nodes + count) with the given store kernel, iterations times
+static void write_nodes(Node *nodes, size_t count, uint64_t iterations, WriteKernel kernel) {
+  for (uint64_t iter = 0; iter < iterations; iter++) {
+    __m128i value = _mm_set1_epi64x(static_cast<long long>(iter));
+    switch (kernel) {
+      case RegularStore:
+        for (size_t i = 0; i < count; i++) {
+          __m128i *p = reinterpret_cast<__m128i *>(&nodes[i]);
+          _mm_store_si128(p, value);
+          _mm_store_si128(p + 1, value);
+          _mm_store_si128(p + 2, value);
+          _mm_store_si128(p + 3, value);
+        }
+        break;
+      case NonTemporalStore:
+        for (size_t i = 0; i < count; i++) {
+          __m128i *p = reinterpret_cast<__m128i *>(&nodes[i]);
+          _mm_stream_si128(p, value);
+          _mm_stream_si128(p + 1, value);
+          _mm_stream_si128(p + 2, value);
+          _mm_stream_si128(p + 3, value);
+        }
+        // Drain the write-combining buffers so the stores are accounted to this pass
+        _mm_sfence();
+        break;
+      case RepStosb: {
+        void *dst = nodes;
+        size_t bytes = count * sizeof(Node);
+        asm volatile("rep stosb" : "+D"(dst), "+c"(bytes) : "a"(static_cast<uint8_t>(iter)) : "memory");
+        break;
+      }
+    }
+    asm volatile("" : : : "memory");
+  }
+}
 
-  // 1. Data generation
-  uint64_t num_nodes = size_kb * 1024 / 64; // Each Node is 64 bytes
+uint64_t write_bandwidth(uint64_t size_kb, WriteKernel kernel) {
+
+  // 1. Initialize data structure
+
+  uint64_t size = std::max<uint64_t>(size_kb * 1024 / 64, 1);
+  std::vector<Node> array(size);
+
+  // 2. Measure data structure
+
+  // Warm-up phase
+  write_nodes(array.data(), size, 1, kernel);
+
+  // Actual measurement: overwrite sequentially as often as the time budget allows
+  auto pass = [&](uint64_t num_iterations) {
+    auto start = std::chrono::high_resolution_clock::now();
+    write_nodes(array.data(), size, num_iterations, kernel);
+    auto end = std::chrono::high_resolution_clock::now();
+    doNotOptimizeAway(array[size - 1].data);
+
+    // Calculate bandwidth from the bytes the program wrote, read-for-ownership traffic is not credited
+    uint64_t total_bytes = num_iterations * size * sizeof(Node);
+    auto duration = std::chrono::duration_cast<std::chrono::nanoseconds>(end - start).count();
+    double seconds_elapsed = duration / 1e9;
+
+    return (total_bytes / seconds_elapsed) / (1024.0 * 1024.0);
+  };
+
+  return static_cast<uint64_t>(summarize(run_adaptive(pass)).median);
+}
+
+uint64_t nt_store_crossover(const std::vector<uint64_t>& sizes_kb) {
+  std::vector<uint64_t> sorted = sizes_kb;
+  std::sort(sorted.begin(), sorted.end());
+
+  // Walk from the largest size down: the crossover is where streaming stores stop winning
+  uint64_t crossover = 0;
+  for (auto it = sorted.rbegin(); it != sorted.rend(); ++it) {
+    uint64_t regular = write_bandwidth(*it, RegularStore);
+    uint64_t streaming = write_bandwidth(*it, NonTemporalStore);
+    if (streaming <= regular) break;
+    crossover = *it;
+  }
+  return crossover;
+}
+
+// Threads hammer the kernel's counters for the given duration, returns combined operations/s
+static uint64_t contended_throughput_for(ContentionKernel kernel, unsigned num_threads, double duration) {
+  using clock = std::chrono::steady_clock;
+  constexpr uint64_t chunk = 256;
+
+  std::vector<unsigned> cores = available_cores();
+  if (num_threads == 0) num_threads = static_cast<unsigned>(cores.size());
+  num_threads = std::max(num_threads, 1u);
+
+  // 1. Initialize counters: packed ones share lines, padded ones get a Node each, plus one shared line
+  std::unique_ptr<uint64_t[], decltype(&std::free)> packed(
+      static_cast<uint64_t *>(std::aligned_alloc(64, (num_threads * sizeof(uint64_t) + 63) / 64 * 64)), &std::free);
+  std::vector<Node> padded(num_threads);
+  Node shared{};
+  for (unsigned t = 0; t < num_threads; t++) {
+    packed[t] = 0;
+    padded[t].data = 0;
+  }
+
+  std::atomic<bool> stop{false};
+  std::barrier sync(num_threads + 1);
+  std::vector<uint64_t> ops(num_threads);
+  std::vector<clock::duration> durations(num_threads);
+
+  // 2. Measure: every thread runs chunks of operations until told to stop
+
+  auto worker = [&](unsigned t) {
+    pin_to_core(cores[t % cores.size()]);
+    std::atomic_ref<uint64_t> own(kernel == PackedCounters ? packed[t] : padded[t].data);
+    std::atomic_ref<uint64_t> target(shared.data);
+    uint64_t done = 0;
+
+    sync.arrive_and_wait();
+    auto start = clock::now();
+    while (!stop.load(std::memory_order_relaxed)) {
+      for (uint64_t i = 0; i < chunk; i++) {
+        switch (kernel) {
+        case PackedCounters:
+        case PaddedCounters:
+          own.store(own.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+          break;
+        case FetchAdd:
+          target.fetch_add(1);
+          break;
+        case CompareExchange: {
+          uint64_t value = target.load(std::memory_order_relaxed);
+          while (!target.compare_exchange_weak(value, value + 1)) {
+          }
+          break;
+        }
+        case Exchange:
+          target.exchange(done + i);
+          break;
+        }
+      }
+      done += chunk;
+    }
+    durations[t] = clock::now() - start;
+    ops[t] = done;
+  };
+
+  std::vector<std::thread> threads;
+  for (unsigned t = 0; t < num_threads; t++) {
+    threads.emplace_back(worker, t);
+  }
+  sync.arrive_and_wait();
+  std::this_thread::sleep_for(std::chrono::duration<double>(duration));
+  stop.store(true);
+  for (auto& thread : threads) {
+    thread.join();
+  }
+
+  double ops_per_second = 0;
+  for (unsigned t = 0; t < num_threads; t++) {
+    ops_per_second += static_cast<double>(ops[t]) / std::chrono::duration<double>(durations[t]).count();
+  }
+  return static_cast<uint64_t>(ops_per_second);
+}
+
+uint64_t contended_throughput(ContentionKernel kernel, unsigned num_threads) {
+  return contended_throughput_for(kernel, num_threads, seconds);
+}
+
+std::vector<uint64_t> contention_scaling(ContentionKernel kernel, unsigned max_threads) {
+  if (max_threads == 0) max_threads = static_cast<unsigned>(available_cores().size());
+  max_threads = std::max(max_threads, 1u);
+
+  std::vector<uint64_t> results;
+  for (unsigned threads = 1; threads <= max_threads; threads++) {
+    results.push_back(contended_throughput_for(kernel, threads, seconds / max_threads));
+  }
+  return results;
+}
+
+// Keys 0 .. num_nodes-1 in the order benchmark_datastructure() looks them up
+static std::vector<uint64_t> make_lookup_sequence(uint64_t num_nodes, AccessPattern access_pattern) {
 
   // Generate keys in ascending order
   std::vector<uint64_t> keys(num_nodes);
@@ -131,34 +1530,62 @@ std::vector<uint64_t> benchmark_datastructure(uint64_t size_kb, AccessPattern ac
   } else { // Random access
     // Create a shuffled sequence ensuring each key is looked up equally
     uint64_t reps = num_lookups / num_nodes;
+    WyRand rng = workload_rng("lookup_sequence");
     for (uint64_t r = 0; r < reps; r++) {
       std::vector<uint64_t> shuffled_keys = keys;
-      std::shuffle(shuffled_keys.begin(), shuffled_keys.end(), std::mt19937(r));
+      std::shuffle(shuffled_keys.begin(), shuffled_keys.end(), rng);
       lookup_sequence.insert(lookup_sequence.end(), shuffled_keys.begin(), shuffled_keys.end());
     }
   }
+  return lookup_sequence;
+}
+
+// The data structures benchmark_datastructure() compares, in result order
+struct DataStructureFactory {
+  const char *name;
+  std::function<std::unique_ptr<IDataStructure>(uint64_t num_nodes)> make;
+};
+
+static const std::vector<DataStructureFactory> datastructures = {
+    {"DirectAccessArray", [](uint64_t n) { return std::make_unique<DirectAccessArray>(n); }},
+    {"BinarySearch", [](uint64_t n) { return std::make_unique<BinarySearch>(n); }},
+    {"ChainedHash(bin_size=1)", [](uint64_t n) { return std::make_unique<ChainedHashTable>(n, 1.0); }},
+    {"ChainedHash(bin_size=16)", [](uint64_t n) { return std::make_unique<ChainedHashTable>(n, 16.0); }},
+    {"OpenAddressing(max_load=0.5)", [](uint64_t n) { return std::make_unique<OpenAddressingHashTable>(n, 0.5); }},
+    {"SwissTable(max_load=0.875)", [](uint64_t n) { return std::make_unique<SwissHashTable>(n, 0.875); }},
+    {"Cuckoo(8-way)", [](uint64_t n) { return std::make_unique<CuckooHashTable>(n); }},
+    {"CsrChainedHash(bin_size=1)", [](uint64_t n) { return std::make_unique<CsrChainedHashTable>(n, 1.0); }},
+    {"CsrChainedHash(bin_size=16)", [](uint64_t n) { return std::make_unique<CsrChainedHashTable>(n, 16.0); }},
+    {"Eytzinger", [](uint64_t n) { return std::make_unique<EytzingerSearch>(n); }},
+    {"BranchlessBinarySearch", [](uint64_t n) { return std::make_unique<BranchlessBinarySearch>(n); }},
+    {"STree", [](uint64_t n) { return std::make_unique<STree>(n, best_read_kernel()); }},
+};
 
-  // 2. Data structure initialization
-  DirectAccessArray ds1(num_nodes);
-  BinarySearch ds2(num_nodes);
-  ChainedHashTable ds3(num_nodes, 1.0);   // bin_size = 1
-  ChainedHashTable ds4(num_nodes, 16.0);  // bin_size = 16
+// Structures up to here report {bw_1 .. bw_4, lat_1 .. lat_4}, later ones append {bw, lat} pairs
+constexpr size_t legacy_datastructures = 4;
 
-  // Populate data structures with nodes in ascending order
+// Build one data structure and populate it with nodes in ascending key order
+static std::unique_ptr<IDataStructure> build_datastructure(const DataStructureFactory& factory, uint64_t num_nodes) {
+  auto ds = factory.make(num_nodes);
   for (uint64_t i = 0; i < num_nodes; i++) {
     Node node;
-    node.key = keys[i];
+    node.key = i;
     node.data = i;
     node.next = nullptr;
-
-    ds1.insert(keys[i], node);
-    ds2.insert(keys[i], node);
-    ds3.insert(keys[i], node);
-    ds4.insert(keys[i], node);
+    ds->insert(i, node);
   }
+  ds->build();
+  return ds;
+}
+
+std::vector<DataStructureResult> benchmark_datastructure_stats(uint64_t size_kb, AccessPattern access_pattern) {
+
+  // 1. Data generation
+  uint64_t num_nodes = size_kb * 1024 / 64; // Each Node is 64 bytes
+  std::vector<uint64_t> lookup_sequence = make_lookup_sequence(num_nodes, access_pattern);
 
   // 3. Measurement helper function
-  auto measure = [&](IDataStructure& ds) -> std::pair<uint64_t, uint64_t> {
+  auto measure = [&](const char *name, IDataStructure& ds) -> DataStructureResult {
     // Warm-up
     uint64_t warmup_sum = 0;
     for (size_t i = 0; i < std::min<size_t>(1000, lookup_sequence.size()); i++) {
@@ -168,47 +1595,200 @@ std::vector<uint64_t> benchmark_datastructure(uint64_t size_kb, AccessPattern ac
     doNotOptimizeAway(warmup_sum);
 
     // Measure latency using cycles
-    PerfEvent e;
-    e.startCounters();
+    auto latency_pass = [&](uint64_t num_iterations) {
+      CycleTimer timer;
+      timer.start();
 
-    uint64_t sum = 0;
-    for (const auto& key : lookup_sequence) {
-      Node* n = ds.lookup(key);
-      if (n) sum = sum + n->data;
-    }
+      uint64_t sum = 0;
+      for (uint64_t iter = 0; iter < num_iterations; iter++) {
+        for (const auto& key : lookup_sequence) {
+          Node* n = ds.lookup(key);
+          if (n) sum = sum + n->data;
+        }
+      }
+      doNotOptimizeAway(sum);
 
-    e.stopCounters();
+      timer.stop();
 
-    uint64_t cycles = static_cast<uint64_t>(e.getCounter("cycles"));
-    uint64_t latency_per_lookup = cycles / lookup_sequence.size();
+      return timer.cycles() / static_cast<double>(num_iterations * lookup_sequence.size());
+    };
 
     // Measure bandwidth using time
-    auto start = std::chrono::high_resolution_clock::now();
+    auto bandwidth_pass = [&](uint64_t num_iterations) {
+      auto start = std::chrono::high_resolution_clock::now();
+
+      uint64_t sum = 0;
+      for (uint64_t iter = 0; iter < num_iterations; iter++) {
+        for (const auto& key : lookup_sequence) {
+          Node* n = ds.lookup(key);
+          if (n) sum = sum + n->data;
+        }
+      }
+      doNotOptimizeAway(sum);
+
+      auto end = std::chrono::high_resolution_clock::now();
+
+      uint64_t total_bytes = num_iterations * lookup_sequence.size() * sizeof(Node);
+      auto duration = std::chrono::duration_cast<std::chrono::nanoseconds>(end - start).count();
+      double seconds_elapsed = duration / 1e9;
+      return (total_bytes / seconds_elapsed) / (1024.0 * 1024.0);
+    };
+
+    // Split the time budget over the latency and bandwidth runs of all data structures
+    double budget = seconds / static_cast<double>(2 * datastructures.size());
+    Measurement latency_per_lookup = summarize(run_adaptive(latency_pass, budget));
+    Measurement bandwidth_mbps = summarize(run_adaptive(bandwidth_pass, budget));
+
+    return {name, bandwidth_mbps, latency_per_lookup};
+  };
+
+  // 2. Build and measure the data structures one at a time, so only one is resident
+  std::vector<DataStructureResult> results;
+  for (auto& factory : datastructures) {
+    auto ds = build_datastructure(factory, num_nodes);
+    results.push_back(measure(factory.name, *ds));
+  }
+  return results;
+}
+
+std::vector<uint64_t> benchmark_datastructure(uint64_t size_kb, AccessPattern access_pattern) {
+  auto results = benchmark_datastructure_stats(size_kb, access_pattern);
+
+  // Return in the specified order: {bw_1, bw_2, bw_3, bw_4, lat_1, lat_2, lat_3, lat_4, bw_5, lat_5, ...}
+  std::vector<uint64_t> medians;
+  for (size_t i = 0; i < legacy_datastructures; i++) medians.push_back(static_cast<uint64_t>(results[i].bandwidth.median));
+  for (size_t i = 0; i < legacy_datastructures; i++) medians.push_back(static_cast<uint64_t>(results[i].latency.median));
+  for (size_t i = legacy_datastructures; i < results.size(); i++) {
+    medians.push_back(static_cast<uint64_t>(results[i].bandwidth.median));
+    medians.push_back(static_cast<uint64_t>(results[i].latency.median));
+  }
+  return medians;
+}
+
+
+std::vector<LookupTail> benchmark_datastructure_tail(uint64_t size_kb, AccessPattern access_pattern,
+                                                     uint64_t sample_every) {
+  sample_every = std::max<uint64_t>(sample_every, 1);
+
+  // 1. Data generation
+  uint64_t num_nodes = size_kb * 1024 / 64; // Each Node is 64 bytes
+  std::vector<uint64_t> lookup_sequence = make_lookup_sequence(num_nodes, access_pattern);
+
+  // 2. Timer overhead: the cheapest empty lfence/rdtsc ... rdtscp/lfence region
+  uint64_t overhead = std::numeric_limits<uint64_t>::max();
+  for (int i = 0; i < 10000; i++) {
+    unsigned aux;
+    _mm_lfence();
+    uint64_t start = __rdtsc();
+    _mm_lfence();
+    uint64_t end = __rdtscp(&aux);
+    _mm_lfence();
+    overhead = std::min(overhead, end - start);
+  }
+
+  // 3. Build and measure the data structures one at a time
+  std::vector<LookupTail> results;
+  for (auto& factory : datastructures) {
+    auto ds = build_datastructure(factory, num_nodes);
 
-    sum = 0;
-    for (const auto& key : lookup_sequence) {
-      Node* n = ds.lookup(key);
+    // Warm-up
+    uint64_t sum = 0;
+    for (size_t i = 0; i < std::min<size_t>(1000, lookup_sequence.size()); i++) {
+      Node* n = ds->lookup(lookup_sequence[i]);
+      if (n) sum = sum + n->data;
+    }
+
+    // Time every sample_every-th lookup, run the others untimed in between
+    LatencyHistogram histogram;
+    for (size_t i = 0; i < lookup_sequence.size(); i++) {
+      if (i % sample_every != 0) {
+        Node* n = ds->lookup(lookup_sequence[i]);
+        if (n) sum = sum + n->data;
+        continue;
+      }
+      unsigned aux;
+      _mm_lfence();
+      uint64_t start = __rdtsc();
+      _mm_lfence();
+      Node* n = ds->lookup(lookup_sequence[i]);
       if (n) sum = sum + n->data;
+      uint64_t end = __rdtscp(&aux);
+      _mm_lfence();
+      histogram.record(end - start > overhead ? end - start - overhead : 0);
     }
     doNotOptimizeAway(sum);
 
-    auto end = std::chrono::high_resolution_clock::now();
+    results.push_back({factory.name, histogram.percentile(0.5), histogram.percentile(0.99),
+                       histogram.percentile(0.999), histogram.max(), overhead, histogram.count()});
+  }
+  return results;
+}
 
-    uint64_t total_bytes = lookup_sequence.size() * sizeof(Node);
-    auto duration = std::chrono::duration_cast<std::chrono::nanoseconds>(end - start).count();
-    double seconds_elapsed = duration / 1e9;
-    uint64_t bandwidth_mbps = static_cast<uint64_t>((total_bytes / seconds_elapsed) / (1024.0 * 1024.0));
+std::vector<LookupCounters> benchmark_datastructure_counters(uint64_t size_kb, AccessPattern access_pattern) {
 
-    return {bandwidth_mbps, latency_per_lookup};
-  };
+  // 1. Data generation
+  uint64_t num_nodes = size_kb * 1024 / 64; // Each Node is 64 bytes
+  std::vector<uint64_t> lookup_sequence = make_lookup_sequence(num_nodes, access_pattern);
+  uint64_t num_iterations = std::max<uint64_t>(1000000 / lookup_sequence.size(), 1);
+  double lookups = static_cast<double>(num_iterations * lookup_sequence.size());
 
-  // Measure all data structures
-  auto [bw1, lat1] = measure(ds1);
-  auto [bw2, lat2] = measure(ds2);
-  auto [bw3, lat3] = measure(ds3);
-  auto [bw4, lat4] = measure(ds4);
+  // 2. Build and measure the data structures one at a time
+  std::vector<LookupCounters> results;
+  for (auto& factory : datastructures) {
+    auto ds = build_datastructure(factory, num_nodes);
 
-  // Return in the specified order: {bw_1, bw_2, bw_3, bw_4, lat_1, lat_2, lat_3, lat_4}
-  return {bw1, bw2, bw3, bw4, lat1, lat2, lat3, lat4};
+    // Warm-up
+    uint64_t sum = 0;
+    for (size_t i = 0; i < std::min<size_t>(1000, lookup_sequence.size()); i++) {
+      Node* n = ds->lookup(lookup_sequence[i]);
+      if (n) sum = sum + n->data;
+    }
+
+    CycleTimer timer;
+    timer.start();
+    for (uint64_t iter = 0; iter < num_iterations; iter++) {
+      for (const auto& key : lookup_sequence) {
+        Node* n = ds->lookup(key);
+        if (n) sum = sum + n->data;
+      }
+    }
+    timer.stop();
+    doNotOptimizeAway(sum);
+
+    auto per_lookup = [&](const char *counter) {
+      double value = timer.counter(counter);
+      return value >= 0 ? value / lookups : -1.0;
+    };
+    results.push_back({factory.name, timer.cycles() / lookups, per_lookup("branch-misses"), per_lookup("instructions"),
+                       per_lookup("LLC-misses")});
+  }
+  return results;
 }
 
+std::vector<InsertResult> insert_throughput(uint64_t size_kb) {
+  using clock = std::chrono::steady_clock;
+  uint64_t num_nodes = size_kb * 1024 / 64; // Each Node is 64 bytes
+
+  std::vector<InsertResult> results;
+  for (auto& factory : datastructures) {
+    auto start = clock::now();
+    auto ds = build_datastructure(factory, num_nodes);
+    double elapsed = std::chrono::duration<double>(clock::now() - start).count();
+    doNotOptimizeAway(ds);
+    results.push_back({factory.name, static_cast<uint64_t>(static_cast<double>(num_nodes) / elapsed)});
+  }
+  return results;
+}
+
+double cuckoo_max_load(uint64_t size_kb) {
+  CuckooHashTable table(size_kb * 1024 / 64);
+  WyRand rng = workload_rng("cuckoo_max_load");
+  Node node{};
+  while (table.rehashes() == 0) {
+    uint64_t key = rng();
+    if (key == CuckooHashTable::emptyKey) continue;
+    node.data = key;
+    table.insert(key, node);
+  }
+  return table.maxLoadReached();
+}
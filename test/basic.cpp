@@ -3,15 +3,20 @@
 #include <thread>
 #include <iostream>
 #include <iomanip>
+#include <sstream>
 #include "PerfEvent.hpp"
 
-// Copied and modified from src/Benchmarking.cpp to include cache miss measurements
-
-class CacheMisses : public PerfEvent {
-public:
-    CacheMisses() : PerfEvent(PERF_TYPE_HARDWARE, PERF_COUNT_HW_CACHE_MISSES) {}
+// Shorter time budget for the probes run inside one test, the previous one comes back on scope exit
+struct ScopedTimeBudget {
+  double previous = time_budget();
+  explicit ScopedTimeBudget(double seconds) { set_time_budget(seconds); }
+  ~ScopedTimeBudget() { set_time_budget(previous); }
+  ScopedTimeBudget(const ScopedTimeBudget &) = delete;
+  ScopedTimeBudget &operator=(const ScopedTimeBudget &) = delete;
 };
 
+// Copied and modified from src/Benchmarking.cpp to include cache miss measurements
+
 std::vector<uint64_t> benchmark_datastructure_with_cache_misses(uint64_t size_kb, AccessPattern access_pattern) {
 
   // 1. Data generation
@@ -31,9 +36,10 @@ std::vector<uint64_t> benchmark_datastructure_with_cache_misses(uint64_t size_kb
     }
   } else { // Random access
     uint64_t reps = num_lookups / num_nodes;
+    WyRand rng = workload_rng("lookup_sequence");
     for (uint64_t r = 0; r < reps; r++) {
       std::vector<uint64_t> shuffled_keys = keys;
-      std::shuffle(shuffled_keys.begin(), shuffled_keys.end(), std::mt19937(r));
+      std::shuffle(shuffled_keys.begin(), shuffled_keys.end(), rng);
       lookup_sequence.insert(lookup_sequence.end(), shuffled_keys.begin(), shuffled_keys.end());
     }
   }
@@ -68,9 +74,7 @@ std::vector<uint64_t> benchmark_datastructure_with_cache_misses(uint64_t size_kb
 
     // Measure latency and cache misses
     PerfEvent e;
-    CacheMisses cm;
     e.startCounters();
-    cm.start();
 
     uint64_t sum = 0;
     for (const auto& key : lookup_sequence) {
@@ -78,13 +82,12 @@ std::vector<uint64_t> benchmark_datastructure_with_cache_misses(uint64_t size_kb
       if (n) sum = sum + n->data;
     }
 
-    cm.stop();
     e.stopCounters();
     doNotOptimizeAway(sum);
 
     uint64_t cycles = static_cast<uint64_t>(e.getCounter("cycles"));
     uint64_t latency_per_lookup = cycles / lookup_sequence.size();
-    uint64_t cache_misses = cm.read();
+    uint64_t cache_misses = static_cast<uint64_t>(e.getCounter("LLC-misses"));
 
     // Measure bandwidth
     auto start = std::chrono::high_resolution_clock::now();
@@ -126,7 +129,8 @@ void print_results(const std::string& title, uint64_t size_kb, const std::string
                    const std::vector<uint64_t>& results) {
   std::cout << "\n";
   print_separator();
-  std::cout << title << " - Size: " << size_kb << " KB, Pattern: " << pattern_name << std::endl;
+  std::cout << title << " - Size: " << size_kb << " KB, Pattern: " << pattern_name
+            << ", Seed: " << workload_seed() << std::endl;
   print_separator();
 
   std::cout << "\nBANDWIDTH (MB/s):" << std::endl;
@@ -209,4 +213,607 @@ TEST_CASE("SUB-TASK 2: Data Structures - Random Large (64MB)", "[benchmark-ds-ra
   }
 
   std::cout << "✓ Random Large Dataset: PASS" << std::endl;
-}
\ No newline at end of file
+}
+
+///// ----------------------- MEASUREMENT STATISTICS ----------------------- /////
+
+TEST_CASE("Statistics: summarize rejects outliers", "[summarize]") {
+  std::vector<double> samples = {10, 11, 10, 12, 11, 10, 11, 10, 12, 1000};
+  Measurement m = summarize(samples);
+
+  REQUIRE(m.samples == 9);
+  REQUIRE(m.outliers == 1);
+  REQUIRE(m.min == 10);
+  REQUIRE(m.median == 11);
+  REQUIRE(m.p99 <= 12);
+  REQUIRE(m.stddev < 1);
+}
+
+TEST_CASE("Statistics: summarize rejects a spike among identical samples", "[summarize]") {
+  std::vector<double> samples = {100, 100, 100, 100, 100, 100, 100, 1000};
+  Measurement m = summarize(samples);
+
+  REQUIRE(m.samples == 7);
+  REQUIRE(m.outliers == 1);
+  REQUIRE(m.median == 100);
+  REQUIRE(m.p99 == 100);
+  REQUIRE(m.stddev == 0);
+}
+
+TEST_CASE("Statistics: latency histogram percentiles", "[histogram]") {
+  LatencyHistogram h;
+  for (uint64_t v = 1; v <= 1000; v++) {
+    h.record(v);
+  }
+  h.record(1000000);
+
+  REQUIRE(h.count() == 1001);
+  REQUIRE(h.max() == 1000000);
+  REQUIRE(h.percentile(0.0) == 1);
+  REQUIRE(h.percentile(0.5) >= 500);
+  REQUIRE(h.percentile(0.5) <= 500 * 1.04);
+  REQUIRE(h.percentile(0.99) >= 990);
+  REQUIRE(h.percentile(0.99) <= 990 * 1.04);
+  REQUIRE(h.percentile(1.0) == 1000000);
+}
+
+TEST_CASE("Workload: seeded streams are reproducible", "[seed]") {
+  uint64_t previous = workload_seed();
+
+  set_workload_seed(1234);
+  WyRand a = workload_rng("lookup_sequence");
+  WyRand b = workload_rng("lookup_sequence");
+  WyRand other = workload_rng("latency");
+  uint64_t first = a();
+  REQUIRE(first == b());
+  REQUIRE(first != other());
+
+  set_workload_seed(4321);
+  REQUIRE(workload_rng("lookup_sequence")() != first);
+
+  for (int i = 0; i < 1000; i++) {
+    REQUIRE(a.below(10) < 10);
+  }
+
+  set_workload_seed(previous);
+}
+
+///// ----------------------- DATA STRUCTURE CORRECTNESS ----------------------- /////
+
+TEST_CASE("Data Structures: open addressing hash table", "[ds-openaddr]") {
+  OpenAddressingHashTable table(16, 0.5);
+  for (uint64_t key = 0; key < 1000; key++) {
+    Node node{};
+    node.data = key * 3;
+    table.insert(key * 7, node);
+  }
+
+  REQUIRE(table.slots_.size() >= 2000);
+  for (uint64_t key = 0; key < 1000; key++) {
+    Node *n = table.lookup(key * 7);
+    REQUIRE(n != nullptr);
+    REQUIRE(n->key == key * 7);
+    REQUIRE(n->data == key * 3);
+  }
+  REQUIRE(table.lookup(1) == nullptr);
+  REQUIRE(table.lookup(7001) == nullptr);
+  REQUIRE(table.lookup(OpenAddressingHashTable::emptyKey) == nullptr);
+  REQUIRE_THROWS_AS(table.insert(OpenAddressingHashTable::emptyKey, Node{}), std::invalid_argument);
+
+  Node replacement{};
+  replacement.data = 42;
+  table.insert(14, replacement);
+  REQUIRE(table.lookup(14)->data == 42);
+}
+
+TEST_CASE("Data Structures: swiss hash table", "[ds-swiss]") {
+  SwissHashTable table(1, 0.875);
+  for (uint64_t key = 0; key < 5000; key++) {
+    Node node{};
+    node.data = key + 1;
+    table.insert(key * 13, node);
+  }
+
+  for (uint64_t key = 0; key < 5000; key++) {
+    Node *n = table.lookup(key * 13);
+    REQUIRE(n != nullptr);
+    REQUIRE(n->key == key * 13);
+    REQUIRE(n->data == key + 1);
+  }
+  REQUIRE(table.lookup(1) == nullptr);
+  REQUIRE(table.lookup(13 * 5000) == nullptr);
+
+  Node replacement{};
+  replacement.data = 7;
+  table.insert(26, replacement);
+  REQUIRE(table.lookup(26)->data == 7);
+}
+
+TEST_CASE("Data Structures: cuckoo hash table", "[ds-cuckoo]") {
+  CuckooHashTable table(8);
+  WyRand rng{99};
+  std::vector<uint64_t> keys;
+  for (int i = 0; i < 20000; i++) {
+    uint64_t key = rng() >> 1;
+    Node node{};
+    node.data = key ^ 0xff;
+    table.insert(key, node);
+    keys.push_back(key);
+  }
+
+  for (uint64_t key : keys) {
+    Node *n = table.lookup(key);
+    REQUIRE(n != nullptr);
+    REQUIRE(n->key == key);
+    REQUIRE(n->data == (key ^ 0xff));
+  }
+  REQUIRE(table.lookup(CuckooHashTable::emptyKey - 1) == nullptr);
+  REQUIRE(table.lookup(CuckooHashTable::emptyKey) == nullptr);
+  REQUIRE_THROWS_AS(table.insert(CuckooHashTable::emptyKey, Node{}), std::invalid_argument);
+  REQUIRE(table.rehashes() > 0);
+  REQUIRE(table.maxLoadReached() > 0.9);
+}
+
+TEST_CASE("Data Structures: CSR chained hash table", "[ds-csr]") {
+  for (double bin_size : {1.0, 16.0}) {
+    CsrChainedHashTable table(1000, bin_size);
+    for (uint64_t key = 0; key < 1000; key++) {
+      Node node{};
+      node.data = key;
+      table.insert(key * 5, node);
+    }
+    Node replacement{};
+    replacement.data = 4242;
+    table.insert(10, replacement);
+    REQUIRE(table.lookup(0) == nullptr); // nothing is visible before build()
+
+    table.build();
+    REQUIRE(table.nodes_.size() == 1000);
+    for (uint64_t key = 0; key < 1000; key++) {
+      Node *n = table.lookup(key * 5);
+      REQUIRE(n != nullptr);
+      REQUIRE(n->key == key * 5);
+      REQUIRE(n->data == (key == 2 ? 4242 : key));
+    }
+    REQUIRE(table.lookup(3) == nullptr);
+
+    // A second build merges newly staged nodes into the existing layout
+    Node extra{};
+    extra.data = 1;
+    table.insert(3, extra);
+    table.build();
+    REQUIRE(table.lookup(3) != nullptr);
+    REQUIRE(table.lookup(4995) != nullptr);
+  }
+}
+
+TEST_CASE("Data Structures: Eytzinger search", "[ds-eytzinger]") {
+  for (uint64_t count : {1, 2, 7, 8, 1000}) {
+    EytzingerSearch search(count);
+    for (uint64_t i = count; i-- > 0;) { // descending, build() has to sort
+      Node node{};
+      node.data = i + 100;
+      search.insert(i * 2 + 1, node);
+    }
+    search.build();
+
+    for (uint64_t i = 0; i < count; i++) {
+      Node *n = search.lookup(i * 2 + 1);
+      REQUIRE(n != nullptr);
+      REQUIRE(n->key == i * 2 + 1);
+      REQUIRE(n->data == i + 100);
+      REQUIRE(search.lookup(i * 2) == nullptr);
+    }
+    REQUIRE(search.lookup(count * 2 + 1) == nullptr);
+
+    // A second build merges newly staged nodes, the later insert of a key wins
+    Node replacement{};
+    replacement.data = 7;
+    search.insert(1, replacement);
+    search.insert(0, replacement);
+    search.build();
+    REQUIRE(search.lookup(1)->data == 7);
+    REQUIRE(search.lookup(0) != nullptr);
+    REQUIRE(search.lookup(count * 2 - 1) != nullptr);
+  }
+}
+
+TEST_CASE("Data Structures: Eytzinger search, incomplete last level", "[ds-eytzinger]") {
+  // Sizes that are not 2^h - 1 leave the last level partly empty, so the descent ends on the k bound
+  // at different depths and the lower bound has to be recovered from the trailing right turns
+  for (uint64_t count : {3, 5, 6, 10, 31, 33, 100, 257, 12345}) {
+    EytzingerSearch search(count);
+    for (uint64_t i = 0; i < count; i++) {
+      Node node{};
+      node.data = i;
+      search.insert(10 + i * 3, node);
+    }
+    search.build();
+
+    for (uint64_t probe = 0; probe < 10 + count * 3 + 5; probe++) {
+      Node *n = search.lookup(probe);
+      bool present = probe >= 10 && (probe - 10) % 3 == 0 && (probe - 10) / 3 < count;
+      REQUIRE((n != nullptr) == present);
+      if (present) REQUIRE(n->data == (probe - 10) / 3);
+    }
+  }
+}
+
+TEST_CASE("Data Structures: branchless binary search", "[ds-branchless]") {
+  for (uint64_t count : {1, 2, 3, 8, 1000, 1023}) {
+    BranchlessBinarySearch search(count);
+    for (uint64_t i = count; i-- > 0;) { // descending, build() has to sort
+      Node node{};
+      node.data = i + 100;
+      search.insert(i * 2 + 1, node);
+    }
+    search.build();
+
+    REQUIRE(search.lookup(0) == nullptr);
+    for (uint64_t i = 0; i < count; i++) {
+      Node *n = search.lookup(i * 2 + 1);
+      REQUIRE(n != nullptr);
+      REQUIRE(n->key == i * 2 + 1);
+      REQUIRE(n->data == i + 100);
+      REQUIRE(search.lookup(i * 2 + 2) == nullptr);
+    }
+  }
+}
+
+TEST_CASE("Data Structures: S-tree", "[ds-stree]") {
+  for (ReadKernel kernel : {ScalarRead, AVX2Read, AVX512Read}) {
+    if (!read_kernel_supported(kernel)) continue;
+    for (uint64_t count : {1, 7, 8, 9, 72, 73, 1000, 5000}) {
+      STree tree(count, kernel);
+      REQUIRE(tree.kernel() == kernel);
+      for (uint64_t i = count; i-- > 0;) { // descending, build() has to sort
+        Node node{};
+        node.data = i + 100;
+        tree.insert(i * 2 + 1, node);
+      }
+      tree.build();
+
+      REQUIRE(tree.lookup(0) == nullptr);
+      for (uint64_t i = 0; i < count; i++) {
+        Node *n = tree.lookup(i * 2 + 1);
+        REQUIRE(n != nullptr);
+        REQUIRE(n->key == i * 2 + 1);
+        REQUIRE(n->data == i + 100);
+        REQUIRE(tree.lookup(i * 2 + 2) == nullptr);
+      }
+      REQUIRE(tree.lookup(STree::emptyKey) == nullptr);
+      REQUIRE_THROWS_AS(tree.insert(STree::emptyKey, Node{}), std::invalid_argument);
+    }
+  }
+}
+
+TEST_CASE("Data Structures: per-lookup counters", "[ds-counters]") {
+  auto counters = benchmark_datastructure_counters(16, AccessPattern::Random);
+
+  REQUIRE(counters.size() == 12); // same order as benchmark_datastructure()
+  REQUIRE(counters.front().name == "DirectAccessArray");
+  REQUIRE(counters.back().name == "STree");
+  for (auto &c : counters) {
+    INFO(c.name);
+    REQUIRE(!c.name.empty());
+    REQUIRE(c.cycles > 0); // TSC ticks when perf is unavailable
+  }
+
+  // The remaining counters are -1 without perf, nothing more to check then
+  if (PerfEvent().events.empty()) return;
+
+  auto find = [&](const std::string &name) {
+    return *std::find_if(counters.begin(), counters.end(), [&](auto &c) { return c.name == name; });
+  };
+  for (auto &c : counters) {
+    INFO(c.name);
+    REQUIRE(c.branch_misses >= 0);
+    REQUIRE(c.instructions >= 0);
+    REQUIRE(c.llc_misses >= 0);
+  }
+  REQUIRE(find("BranchlessBinarySearch").branch_misses < find("BinarySearch").branch_misses);
+}
+
+TEST_CASE("Data Structures: per-lookup latency tail", "[ds-tail]") {
+  // 16 KB = 256 nodes, looked up 10000 times in order
+  uint64_t sample_every = 16;
+  auto tails = benchmark_datastructure_tail(16, AccessPattern::Sequential, sample_every);
+
+  REQUIRE(tails.size() == 12); // same order as benchmark_datastructure()
+  REQUIRE(tails.front().name == "DirectAccessArray");
+  REQUIRE(tails.back().name == "STree");
+  for (auto &t : tails) {
+    INFO(t.name);
+    REQUIRE(t.p50 <= t.p99);
+    REQUIRE(t.p99 <= t.p999);
+    REQUIRE(t.p999 <= t.max);
+    REQUIRE(t.samples == (10000 + sample_every - 1) / sample_every);
+  }
+}
+
+TEST_CASE("Data Structures: insert throughput and cuckoo load", "[ds-insert]") {
+  auto results = insert_throughput(64);
+  REQUIRE(results.size() == 12);
+  for (auto &r : results) {
+    INFO(r.name);
+    REQUIRE(r.inserts_per_second > 0);
+  }
+
+  double load = cuckoo_max_load(64);
+  REQUIRE(load > 0.5);
+  REQUIRE(load <= 1.0);
+}
+
+///// ----------------------- MEMORY PROBES ----------------------- /////
+
+TEST_CASE("Prefetch sweep: strided order is a permutation", "[prefetch]") {
+  WyRand rng{7};
+  // 96 lines = 6 KB: one full page and a partial one
+  for (size_t size : {2, 63, 64, 65, 96, 1000}) {
+    for (uint64_t stride : {1, 2, 3, 64}) {
+      for (bool backward : {false, true}) {
+        for (bool page_offset : {false, true}) {
+          std::vector<size_t> order = strided_permutation(size, stride, backward, page_offset, rng);
+          REQUIRE(order.size() == size);
+          std::sort(order.begin(), order.end());
+          for (size_t i = 0; i < size; i++) REQUIRE(order[i] == i);
+        }
+      }
+    }
+  }
+}
+
+TEST_CASE("Prefetch sweep: one result per stride, direction and offset", "[prefetch]") {
+  auto results = prefetch_sweep(64);
+
+  REQUIRE(results.size() == 7 * 2 * 2); // strides 1 .. 64 lines
+  for (size_t i = 0; i < results.size(); i++) {
+    REQUIRE(results[i].stride == uint64_t(1) << (i / 4));
+    REQUIRE(results[i].backward == bool(i / 2 % 2));
+    REQUIRE(results[i].page_offset == bool(i % 2));
+    REQUIRE(results[i].strided_ns > 0);
+    REQUIRE(results[i].random_ns > 0);
+    REQUIRE(results[i].saving == Approx(1 - results[i].strided_ns / results[i].random_ns));
+  }
+
+  std::ostringstream out;
+  print_prefetch_sweep(out, results);
+  std::string text = out.str();
+  REQUIRE(std::count(text.begin(), text.end(), '\n') == 1 + 28);
+}
+
+TEST_CASE("Latency: Sattolo chain is one cycle over all nodes", "[sattolo]") {
+  // Below 2^20 nodes the chain is built serially, from there on in classes spliced together
+  for (size_t count : {size_t(1), size_t(2), size_t(5), size_t(1000), size_t(4099), (size_t(1) << 20) + 3}) {
+    std::vector<Node> nodes(count);
+    std::vector<Node *> reference;
+    for (unsigned threads : {1u, 3u, 0u}) {
+      Node *head = link_sattolo_cycle(nodes.data(), count, 1234 + count, threads);
+
+      std::vector<bool> seen(count, false);
+      std::vector<Node *> chain;
+      Node *current = head;
+      for (size_t hop = 0; hop < count; hop++) {
+        size_t index = static_cast<size_t>(current - nodes.data());
+        REQUIRE(index < count);
+        REQUIRE(!seen[index]);
+        REQUIRE(current->data == index);
+        seen[index] = true;
+        chain.push_back(current);
+        current = current->next;
+      }
+      REQUIRE(current == head);
+
+      // The thread count must not change the chain of a seed
+      if (reference.empty()) reference = chain;
+      REQUIRE(chain == reference);
+    }
+  }
+}
+
+TEST_CASE("Bandwidth: one figure per read kernel", "[bandwidth-isa]") {
+  ScopedTimeBudget budget(0.05);
+  auto bw = bandwidth_per_isa(64);
+
+  REQUIRE(bw.size() == 3);
+  REQUIRE(bw[0] > 0); // scalar runs everywhere
+  for (ReadKernel kernel : {ScalarRead, AVX2Read, AVX512Read}) {
+    REQUIRE((bw[kernel] > 0) == read_kernel_supported(kernel));
+  }
+}
+
+TEST_CASE("Cache hierarchy: knees of a latency curve", "[cache-hierarchy]") {
+  // L1 plateau, step to L2, step to DRAM
+  std::vector<double> curve = {4, 4, 4.2, 4, 14, 14.5, 15, 14, 14, 80, 95, 100, 101, 100};
+  auto knees = detect_knees(curve, 0.25, 1.0);
+  REQUIRE(knees == std::vector<size_t>{3, 8});
+
+  // A single noisy point is no knee, and a flat curve has none
+  REQUIRE(detect_knees({4, 4, 9, 4, 4, 4}, 0.25, 1.0).empty());
+  REQUIRE(detect_knees(std::vector<double>(10, 7.0)).empty());
+  REQUIRE(detect_knees({}).empty());
+}
+
+TEST_CASE("Cache hierarchy: sysfs cache sizes", "[cache-hierarchy]") {
+  REQUIRE(parse_cache_size_kb("48K") == 48);
+  REQUIRE(parse_cache_size_kb("2048K") == 2048);
+  REQUIRE(parse_cache_size_kb("105M") == 105 * 1024);
+  REQUIRE(parse_cache_size_kb("1G") == 1024 * 1024);
+  REQUIRE(parse_cache_size_kb("32768") == 32);
+  REQUIRE(parse_cache_size_kb("") == 0);
+  REQUIRE(parse_cache_size_kb("K") == 0);
+}
+
+TEST_CASE("Cache hierarchy: table has one row per level", "[cache-hierarchy]") {
+  std::vector<CacheLevel> levels = {{1, "Data", 48, 48, 5, 1.5, 200000},
+                                    {2, "Unified", 2048, 1024, 16, 4.8, 90000},
+                                    {3, "Memory", 0, 0, 250, 80, 12000}};
+  std::ostringstream out;
+  print_cache_hierarchy(out, levels);
+
+  std::string text = out.str();
+  REQUIRE(std::count(text.begin(), text.end(), '\n') == 4);
+  REQUIRE(text.find("Unified") != std::string::npos);
+  REQUIRE(text.find("2048") != std::string::npos);
+  REQUIRE(text.find("250.0") != std::string::npos);
+}
+
+TEST_CASE("NUMA matrix: printed as two node x node tables", "[numa]") {
+  NumaMatrix matrix{2, {100, 180, 190, 110}, {12000, 7000, 6900, 11800}};
+  std::ostringstream out;
+  print_numa_matrix(out, matrix);
+
+  std::istringstream in(out.str());
+  std::vector<std::string> lines;
+  for (std::string line; std::getline(in, line);) lines.push_back(line);
+  REQUIRE(lines.size() == 8); // title, header and one row per node, twice
+  REQUIRE(lines[0].find("LATENCY") != std::string::npos);
+  REQUIRE(lines[4].find("BANDWIDTH") != std::string::npos);
+
+  // Row = cpu node, column = memory node
+  std::istringstream row(lines[3]);
+  uint64_t cpu, local, remote;
+  row >> cpu >> remote >> local;
+  REQUIRE(cpu == 1);
+  REQUIRE(remote == 190);
+  REQUIRE(local == 110);
+}
+
+TEST_CASE("NUMA matrix: every pair with cpus and memory is measured", "[numa]") {
+  ScopedTimeBudget budget(0.05);
+  NumaMatrix matrix = numa_matrix(1024);
+
+  REQUIRE(matrix.nodes >= 1);
+  REQUIRE(matrix.latency.size() == matrix.nodes * matrix.nodes);
+  REQUIRE(matrix.bandwidth.size() == matrix.nodes * matrix.nodes);
+  REQUIRE(matrix.latency[0] > 0);
+  REQUIRE(matrix.bandwidth[0] > 0);
+}
+
+TEST_CASE("Loaded latency: idle point first, then one point per delay", "[loaded-latency]") {
+  auto points = loaded_latency(1024, 1, {0, 200});
+
+  REQUIRE(points.size() == 3);
+  REQUIRE(points[0].bandwidth == 0); // idle
+  REQUIRE(points[1].delay == 200);   // lightest load first
+  REQUIRE(points[2].delay == 0);
+  for (auto &point : points) {
+    REQUIRE(point.latency_cycles > 0);
+    REQUIRE(point.latency_ns > 0);
+  }
+  REQUIRE(points[1].bandwidth > 0);
+  REQUIRE(points[2].bandwidth > 0);
+
+  std::ostringstream out;
+  print_loaded_latency(out, points);
+  std::string text = out.str();
+  REQUIRE(std::count(text.begin(), text.end(), '\n') == 4);
+}
+
+TEST_CASE("Bandwidth: multi-threaded figure and one per thread", "[bandwidth-mt]") {
+  ScopedTimeBudget budget(0.05);
+  auto bw = bandwidth_mt(1024, 2);
+  auto bw_all = bandwidth_mt(1024, 0);
+
+  REQUIRE(bw.size() == 3);
+  for (uint64_t value : bw) REQUIRE(value > 0);
+  REQUIRE(bw_all.size() >= 2); // every core we may run on
+  REQUIRE(bw_all[0] > 0);
+}
+
+TEST_CASE("Bandwidth: STREAM kernels", "[stream]") {
+  ScopedTimeBudget budget(0.05);
+  std::vector<uint64_t> bw;
+  for (StreamKernel kernel : {Copy, Scale, Add, Triad}) bw.push_back(stream_bandwidth(1024, kernel));
+
+  for (uint64_t value : bw) REQUIRE(value > 0);
+}
+
+TEST_CASE("Bandwidth: store kernels and non-temporal crossover", "[write-bandwidth]") {
+  ScopedTimeBudget budget(0.05);
+  std::vector<uint64_t> bw;
+  for (WriteKernel kernel : {RegularStore, NonTemporalStore, RepStosb}) bw.push_back(write_bandwidth(1024, kernel));
+  std::vector<uint64_t> sizes_kb = {64, 1024, 16384};
+  uint64_t crossover = nt_store_crossover(sizes_kb);
+
+  for (uint64_t value : bw) REQUIRE(value > 0);
+  REQUIRE((crossover == 0 || std::find(sizes_kb.begin(), sizes_kb.end(), crossover) != sizes_kb.end()));
+}
+
+TEST_CASE("Latency: interleaved chases overlap their misses", "[mlp]") {
+  auto ns = latency_mlp(16384, 8);
+
+  REQUIRE(ns.size() == 8);
+  for (double value : ns) REQUIRE(value > 0);
+  REQUIRE(ns.back() < ns.front()); // 8 chains in flight beat one
+  REQUIRE(latency_mlp(1, 32).size() == 16); // never more chains than nodes
+}
+
+TEST_CASE("Page sizes: one result per page size, falling back to smaller pages", "[page-size]") {
+  ScopedTimeBudget budget(0.05);
+  auto results = page_size_sweep(8192);
+
+  REQUIRE(results.size() == 4);
+  PageSize requested[] = {Page4K, PageTHP, Page2M, Page1G};
+  for (size_t i = 0; i < results.size(); i++) {
+    REQUIRE(results[i].requested == requested[i]);
+    REQUIRE(results[i].backing >= Page4K);
+    REQUIRE(results[i].backing <= results[i].requested);
+    REQUIRE(results[i].latency > 0);
+    REQUIRE(results[i].bandwidth > 0);
+  }
+  REQUIRE(results[0].backing == Page4K);
+}
+
+TEST_CASE("TLB: latency curve over a page sweep", "[tlb]") {
+  TlbProfile profile = tlb_profile(256);
+
+  REQUIRE(profile.pages.front() == 4);
+  REQUIRE(profile.pages.back() <= 256);
+  REQUIRE(std::is_sorted(profile.pages.begin(), profile.pages.end()));
+  REQUIRE(profile.latency.size() == profile.pages.size());
+  REQUIRE(profile.cache_latency.size() == profile.pages.size());
+  for (size_t i = 0; i < profile.pages.size(); i++) {
+    REQUIRE(profile.latency[i] > 0);
+    REQUIRE(profile.cache_latency[i] > 0);
+  }
+  // Entry counts are read off the sweep, so they are probed sizes
+  for (uint64_t entries : {profile.l1_dtlb_entries, profile.stlb_entries}) {
+    REQUIRE((entries == 0 || std::count(profile.pages.begin(), profile.pages.end(), entries) == 1));
+  }
+}
+
+TEST_CASE("Time budget: probes repeat passes and stop at the budget", "[time-budget]") {
+  using clock = std::chrono::steady_clock;
+  double previous = time_budget();
+  {
+    ScopedTimeBudget inner(0.5);
+    REQUIRE(time_budget() == 0.5);
+  }
+  REQUIRE(time_budget() == previous);
+
+  ScopedTimeBudget budget(0.2);
+
+  auto start = clock::now();
+  Measurement m = bandwidth_stats(64);
+  double elapsed = std::chrono::duration<double>(clock::now() - start).count();
+
+  REQUIRE(m.samples + m.outliers > 1);
+  REQUIRE(m.min > 0);
+  REQUIRE(m.min <= m.median);
+  REQUIRE(m.median <= m.p99);
+  REQUIRE(elapsed < 1.0); // budget plus setup, not the default 10 s
+}
+
+TEST_CASE("Contention: one throughput per thread count", "[contention]") {
+  ScopedTimeBudget budget(0.1);
+  std::vector<std::vector<uint64_t>> scaling;
+  for (ContentionKernel kernel : {PackedCounters, PaddedCounters, FetchAdd, CompareExchange, Exchange}) {
+    scaling.push_back(contention_scaling(kernel, 2));
+  }
+
+  for (auto &ops : scaling) {
+    REQUIRE(ops.size() == 2);
+    for (uint64_t value : ops) REQUIRE(value > 0);
+  }
+}
@@ -68,6 +68,7 @@ int main() {
     std::cout << "╔════════════════════════════════════════════════════════════════╗\n";
     std::cout << "║         SUB-TASK 2: DATA STRUCTURE BENCHMARKING TEST          ║\n";
     std::cout << "╚════════════════════════════════════════════════════════════════╝\n";
+    std::cout << "Workload seed: " << workload_seed() << "\n";
 
     // Test cases covering small, medium, and large datasets
     // Both sequential and random access patterns